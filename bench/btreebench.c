@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../src/btree/btree.h"
+#include "../src/sortedset/sortedset.h"
+#include "../src/vector/vector.h"
+
+// Number of entries in the benchmarked trees.
+#define LENGTH 1000000
+
+// Number of lookups and range scans timed.
+#define QUERIES 1000000
+
+// Number of entries visited by each range scan.
+#define SCAN_LENGTH 100
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main() {
+  srand(3);
+  vector *keys = vector_create(LENGTH);
+  for (int i = 0; i < LENGTH; i++) {
+    vector_push(keys, i * 4);
+  }
+  int *queries = malloc(QUERIES * sizeof(int));
+  for (int i = 0; i < QUERIES; i++) {
+    queries[i] = rand() % (LENGTH * 4);
+  }
+
+  double start = now();
+  btree *loaded = btree_create_from_vector(keys, NULL);
+  printf("bulk load:   %8.1f ns per entry\n", (now() - start) / LENGTH * 1e9);
+
+  start = now();
+  btree *tree = btree_create();
+  for (int i = 0; i < LENGTH; i++) {
+    btree_put(tree, queries[i], i);
+  }
+  printf("put:         %8.1f ns per entry\n", (now() - start) / LENGTH * 1e9);
+
+  size_t found = 0;
+  start = now();
+  for (int i = 0; i < QUERIES; i++) {
+    found += btree_contains(loaded, queries[i]);
+  }
+  printf("contains:    %8.1f ns per lookup\n",
+         (now() - start) / QUERIES * 1e9);
+
+  sortedset *set = sortedset_create_from_vector(keys);
+  start = now();
+  for (int i = 0; i < QUERIES; i++) {
+    found += sortedset_contains(set, queries[i]);
+  }
+  printf("sortedset:   %8.1f ns per lookup\n",
+         (now() - start) / QUERIES * 1e9);
+  sortedset_destroy(set);
+
+  long long sum = 0;
+  start = now();
+  for (int i = 0; i < QUERIES; i++) {
+    btree_iterator it = btree_lower_bound(loaded, queries[i]);
+    int key;
+    int value;
+    for (int j = 0; j < SCAN_LENGTH && btree_iterator_next(&it, &key, &value);
+         j++) {
+      sum += key;
+    }
+  }
+  printf("range scan:  %8.1f ns per %d entries\n",
+         (now() - start) / QUERIES * 1e9, SCAN_LENGTH);
+  printf("checksum:    %lu %lld\n", found, sum);
+
+  btree_destroy(tree);
+  btree_destroy(loaded);
+  free(queries);
+  vector_destroy(keys);
+}
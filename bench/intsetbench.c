@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../src/intset/intset.h"
+#include "../src/vector/vector.h"
+
+// Number of values in each benchmarked set.
+#define LENGTH 10000000
+
+// Number of times each benchmark is repeated.
+#define ROUNDS 10
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Creates a set of LENGTH random values from [0, range).
+static intset *random_set(int range) {
+  vector *vec = vector_create(LENGTH);
+  for (int i = 0; i < LENGTH; i++) {
+    vector_push(vec, rand() % range);
+  }
+  intset *set = intset_create_from_vector(vec);
+  vector_destroy(vec);
+  return set;
+}
+
+// Intersects two sets ROUNDS times over. Returns the time taken in seconds.
+static double bench_intersection(intset *set1, intset *set2, size_t *length) {
+  double start = now();
+  for (int round = 0; round < ROUNDS; round++) {
+    intset *result = intset_intersection(set1, set2);
+    *length = intset_length(result);
+    intset_destroy(result);
+  }
+  return (now() - start) / ROUNDS;
+}
+
+int main() {
+  srand(7);
+  // Dense sets end up as bitmaps, sparse ones as arrays
+  int ranges[2] = {LENGTH * 2, LENGTH * 100};
+  for (int i = 0; i < 2; i++) {
+    double start = now();
+    intset *set1 = random_set(ranges[i]);
+    intset *set2 = random_set(ranges[i]);
+    double build_time = now() - start;
+
+    size_t length;
+    double time = bench_intersection(set1, set2, &length);
+    size_t memory = intset_memory_usage(set1);
+    printf("%s: %lu values in %.1f MB (%.2f bytes per value), built in "
+           "%.3f s\n",
+           i == 0 ? "dense" : "sparse", intset_length(set1), memory / 1e6,
+           (double)memory / intset_length(set1), build_time / 2);
+    printf("  intersection of %lu values: %.2f ms\n", length, time * 1e3);
+    intset_destroy(set1);
+    intset_destroy(set2);
+  }
+}
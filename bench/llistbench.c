@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../src/llist/llist.h"
+
+// Number of values in the benchmarked lists.
+#define LENGTH 1000000
+
+// Number of times each benchmark is repeated.
+#define ROUNDS 10
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Fills a list, churns it by moving values from the front to the back, sums it
+// and finally clears it, ROUNDS times over. Returns the time taken in seconds.
+static double bench(llist *list, long long *checksum) {
+  double start = now();
+  for (int round = 0; round < ROUNDS; round++) {
+    for (int i = 0; i < LENGTH; i++) {
+      llist_push_back(list, i);
+    }
+    for (int i = 0; i < LENGTH; i++) {
+      llist_push_back(list, llist_pop_front(list));
+    }
+    while (!llist_empty(list)) {
+      *checksum += llist_pop_back(list);
+    }
+    for (int i = 0; i < LENGTH; i++) {
+      llist_push_front(list, i);
+    }
+    llist_clear(list);
+  }
+  return now() - start;
+}
+
+// Builds a list of LENGTH values from an array ROUNDS times over, either by
+// pushing values one at a time or in bulk. Returns the time taken in seconds.
+static double bench_build(int *values, int mode, long long *checksum) {
+  double start = now();
+  for (int round = 0; round < ROUNDS; round++) {
+    llist *list;
+    if (mode == 0) {
+      list = llist_create();
+      for (int i = 0; i < LENGTH; i++) {
+        llist_push_back(list, values[i]);
+      }
+    } else if (mode == 1) {
+      list = llist_create_from_values(values, LENGTH);
+    } else {
+      list = llist_create_pooled_from_values(values, LENGTH);
+    }
+    *checksum += llist_back(list);
+    llist_destroy(list);
+  }
+  return now() - start;
+}
+
+int main() {
+  long long checksum = 0;
+
+  llist *list = llist_create();
+  double malloc_time = bench(list, &checksum);
+  llist_destroy(list);
+
+  list = llist_create_pooled();
+  double pooled_time = bench(list, &checksum);
+  llist_destroy(list);
+
+  llist_pool *pool = llist_pool_create(4096);
+  list = llist_create_with_pool(pool);
+  double shared_time = bench(list, &checksum);
+  llist_destroy(list);
+  llist_pool_destroy(pool);
+
+  printf("malloc:      %.3f s\n", malloc_time);
+  printf("pooled:      %.3f s (%.2fx)\n", pooled_time,
+         malloc_time / pooled_time);
+  printf("shared pool: %.3f s (%.2fx)\n", shared_time,
+         malloc_time / shared_time);
+
+  int *values = malloc(LENGTH * sizeof(int));
+  if (values == NULL) {
+    return 1;
+  }
+  for (int i = 0; i < LENGTH; i++) {
+    values[i] = i;
+  }
+  double push_build_time = bench_build(values, 0, &checksum);
+  double bulk_build_time = bench_build(values, 1, &checksum);
+  double pooled_build_time = bench_build(values, 2, &checksum);
+  free(values);
+
+  printf("build by push:       %.3f s\n", push_build_time);
+  printf("build in bulk:       %.3f s (%.2fx)\n", bulk_build_time,
+         push_build_time / bulk_build_time);
+  printf("build pooled bulk:   %.3f s (%.2fx)\n", pooled_build_time,
+         push_build_time / pooled_build_time);
+  printf("checksum:    %lld\n", checksum);
+}
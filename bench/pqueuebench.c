@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../src/llist/llist.h"
+#include "../src/pqueue/pqueue.h"
+
+// Number of pop-and-push steps in each hold benchmark.
+#define STEPS 2000000
+
+// Number of values heaps are built from in the build benchmark.
+#define BUILD_LENGTH 1000000
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Runs the classic hold model on a heap of a given size: pops the smallest
+// value and pushes it back with a random increment, like an event queue does.
+// When `fused` is true, pqueue_replace_top does both in one pass. Returns the
+// time taken per step in nanoseconds.
+static double bench_heap(size_t size, size_t arity, bool fused,
+                         long long *checksum) {
+  pqueue *pq = pqueue_create(size, arity);
+  for (size_t i = 0; i < size; i++) {
+    pqueue_push(pq, rand() % 1000);
+  }
+  int *increments = malloc(STEPS * sizeof(int));
+  for (int i = 0; i < STEPS; i++) {
+    increments[i] = rand() % 1000;
+  }
+
+  double start = now();
+  for (int i = 0; i < STEPS; i++) {
+    if (fused) {
+      pqueue_replace_top(pq, pqueue_peek(pq) + increments[i]);
+    } else {
+      pqueue_push(pq, pqueue_pop(pq) + increments[i]);
+    }
+  }
+  double time = now() - start;
+
+  *checksum += pqueue_peek(pq);
+  free(increments);
+  pqueue_destroy(pq);
+  return time / STEPS * 1e9;
+}
+
+// Runs the same hold model on a list kept sorted by inserting each value in
+// front of the first larger one. Uses fewer steps since each one is O(n).
+static double bench_sorted_list(size_t size, long long *checksum) {
+  int steps = STEPS / 100;
+  llist *list = llist_create_pooled();
+  for (size_t i = 0; i < size; i++) {
+    llist_push_back(list, i);
+  }
+
+  double start = now();
+  for (int i = 0; i < steps; i++) {
+    int value = llist_pop_front(list) + rand() % 1000;
+    llist_cursor cursor = llist_cursor_front(list);
+    while (!llist_cursor_at_end(&cursor) &&
+           llist_cursor_get(&cursor) <= value) {
+      llist_cursor_next(&cursor);
+    }
+    llist_cursor_insert_before(&cursor, value);
+  }
+  double time = now() - start;
+
+  *checksum += llist_front(list);
+  llist_destroy(list);
+  return time / steps * 1e9;
+}
+
+// Builds a heap from BUILD_LENGTH random values, either by pushing them one at
+// a time or by heapifying them all at once. Returns the time taken in
+// milliseconds.
+static double bench_build(const int *values, size_t arity, bool heapify,
+                          long long *checksum) {
+  double start = now();
+  pqueue *pq;
+  if (heapify) {
+    pq = pqueue_create_from_array(values, BUILD_LENGTH, arity);
+  } else {
+    pq = pqueue_create(BUILD_LENGTH, arity);
+    for (int i = 0; i < BUILD_LENGTH; i++) {
+      pqueue_push(pq, values[i]);
+    }
+  }
+  double time = now() - start;
+  *checksum += pqueue_peek(pq);
+  pqueue_destroy(pq);
+  return time * 1e3;
+}
+
+int main() {
+  long long checksum = 0;
+  srand(1);
+
+  size_t sizes[3] = {100, 10000, 1000000};
+  for (int i = 0; i < 3; i++) {
+    printf("hold, %zu values:\n", sizes[i]);
+    printf("  2-ary:               %6.1f ns/op\n",
+           bench_heap(sizes[i], 2, false, &checksum));
+    printf("  4-ary:               %6.1f ns/op\n",
+           bench_heap(sizes[i], 4, false, &checksum));
+    printf("  8-ary:               %6.1f ns/op\n",
+           bench_heap(sizes[i], 8, false, &checksum));
+    printf("  4-ary, replace_top:  %6.1f ns/op\n",
+           bench_heap(sizes[i], 4, true, &checksum));
+    if (sizes[i] <= 10000) {
+      printf("  sorted list:         %6.1f ns/op\n",
+             bench_sorted_list(sizes[i], &checksum));
+    }
+  }
+
+  int *values = malloc(BUILD_LENGTH * sizeof(int));
+  if (values == NULL) {
+    return 1;
+  }
+  for (int i = 0; i < BUILD_LENGTH; i++) {
+    values[i] = rand();
+  }
+  printf("build %d values:\n", BUILD_LENGTH);
+  printf("  2-ary by push:       %6.1f ms\n",
+         bench_build(values, 2, false, &checksum));
+  printf("  2-ary heapify:       %6.1f ms\n",
+         bench_build(values, 2, true, &checksum));
+  printf("  4-ary by push:       %6.1f ms\n",
+         bench_build(values, 4, false, &checksum));
+  printf("  4-ary heapify:       %6.1f ms\n",
+         bench_build(values, 4, true, &checksum));
+  free(values);
+
+  printf("checksum: %lld\n", checksum);
+}
@@ -0,0 +1,184 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/segvector/segvector.h"
+#include "../src/vector/vector.h"
+
+// Number of values pushed in total, split evenly between the threads.
+#define COUNT 20000000
+
+// Number of values pushed at a time in batched mode.
+#define BATCH 64
+
+// Largest number of threads benchmarked on any machine.
+#define MAX_THREADS 64
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// A vector guarded by a mutex, which is what concurrent writers needed before
+// the segmented vector existed.
+typedef struct locked_vector {
+  pthread_mutex_t mutex;
+  vector *vec;
+} locked_vector;
+
+typedef enum mode { LOCKED, SEGMENTED, BATCHED } mode;
+
+typedef struct task {
+  mode m;
+  locked_vector *locked;
+  segvector *sv;
+  int first;
+  int count;
+  // Set if a push failed, which ends the task early.
+  bool failed;
+} task;
+
+// Pushes the values of a given task.
+static void *push_values(void *arg) {
+  task *t = arg;
+  int batch[BATCH];
+  for (int i = t->first; i < t->first + t->count;) {
+    if (t->m == LOCKED) {
+      pthread_mutex_lock(&t->locked->mutex);
+      bool pushed = vector_push(t->locked->vec, i++);
+      pthread_mutex_unlock(&t->locked->mutex);
+      if (!pushed) {
+        t->failed = true;
+        break;
+      }
+    } else if (t->m == SEGMENTED) {
+      if (!segvector_push(t->sv, i++, NULL)) {
+        t->failed = true;
+        break;
+      }
+    } else {
+      int n = t->first + t->count - i < BATCH ? t->first + t->count - i : BATCH;
+      for (int j = 0; j < n; j++) {
+        batch[j] = i + j;
+      }
+      size_t pushed = segvector_push_many(t->sv, batch, n, NULL);
+      if (pushed == 0) {
+        t->failed = true;
+        break;
+      }
+      i += pushed;
+    }
+  }
+  return NULL;
+}
+
+// Pushes COUNT values from a given number of threads in a given mode. Returns
+// the time taken in seconds, or a negative number if the run could not be set
+// up, a thread failed to start or not every value was pushed.
+static double bench(mode m, size_t nthreads) {
+  locked_vector locked;
+  pthread_mutex_init(&locked.mutex, NULL);
+  locked.vec = vector_create(16);
+  segvector *sv = segvector_create(COUNT);
+  if (locked.vec == NULL || sv == NULL) {
+    fprintf(stderr, "Failed to create vectors\n");
+    segvector_destroy(sv);
+    vector_destroy(locked.vec);
+    pthread_mutex_destroy(&locked.mutex);
+    return -1;
+  }
+
+  pthread_t threads[MAX_THREADS];
+  task tasks[MAX_THREADS];
+  int per_thread = COUNT / nthreads;
+  size_t started = 0;
+  double start = now();
+  for (size_t i = 0; i < nthreads; i++) {
+    int count = i + 1 < nthreads ? per_thread : COUNT - per_thread * (int)i;
+    tasks[i] = (task){m, &locked, sv, per_thread * (int)i, count, false};
+    if (pthread_create(&threads[i], NULL, push_values, &tasks[i]) != 0) {
+      fprintf(stderr, "Failed to start thread\n");
+      break;
+    }
+    started++;
+  }
+  // The threads that did start use the vectors and tasks, so they are waited
+  // for even if the run failed
+  for (size_t i = 0; i < started; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  double elapsed = now() - start;
+
+  bool failed = started < nthreads;
+  for (size_t i = 0; i < started; i++) {
+    failed |= tasks[i].failed;
+  }
+  size_t length =
+      m == LOCKED ? vector_length(locked.vec) : segvector_length(sv);
+  if (!failed && length != COUNT) {
+    fprintf(stderr, "Pushed %lu values instead of %d\n", length, COUNT);
+    failed = true;
+  } else if (started == nthreads && failed) {
+    fprintf(stderr, "Failed to push values\n");
+  }
+  if (failed) {
+    elapsed = -1;
+  }
+  segvector_destroy(sv);
+  vector_destroy(locked.vec);
+  pthread_mutex_destroy(&locked.mutex);
+  return elapsed;
+}
+
+int main() {
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t max_threads = cores > 1 ? cores : 1;
+  if (max_threads > MAX_THREADS) {
+    max_threads = MAX_THREADS;
+  }
+  // Always show some contention, even on machines with few cores
+  if (max_threads < 4) {
+    max_threads = 4;
+  }
+
+  printf("%7s %16s %16s %16s\n", "threads", "mutex + vector", "segvector",
+         "batched");
+  for (size_t nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+    printf("%7lu", nthreads);
+    mode modes[3] = {LOCKED, SEGMENTED, BATCHED};
+    for (int i = 0; i < 3; i++) {
+      double elapsed = bench(modes[i], nthreads);
+      if (elapsed < 0) {
+        printf(" %16s", "failed");
+      } else {
+        printf(" %12.2f M/s", COUNT / elapsed / 1e6);
+      }
+    }
+    printf("\n");
+  }
+}
@@ -0,0 +1,198 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/llist/llist.h"
+#include "../src/spsc/spsc.h"
+
+// Number of values passed from the producer to the consumer.
+#define COUNT 20000000
+
+// Number of values pushed and popped at a time in batched mode.
+#define BATCH 256
+
+// Number of round trips timed for latency.
+#define ROUND_TRIPS 200000
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// A linked list guarded by a mutex, as used before the SPSC queue existed.
+typedef struct locked_llist {
+  pthread_mutex_t mutex;
+  llist *list;
+} locked_llist;
+
+typedef struct channel {
+  locked_llist *locked;
+  spsc *q;
+  bool batched;
+} channel;
+
+static void *produce(void *arg) {
+  channel *ch = arg;
+  int batch[BATCH];
+  for (int i = 0; i < COUNT;) {
+    if (ch->locked != NULL) {
+      pthread_mutex_lock(&ch->locked->mutex);
+      llist_push_back(ch->locked->list, i++);
+      pthread_mutex_unlock(&ch->locked->mutex);
+    } else if (ch->batched) {
+      int n = COUNT - i < BATCH ? COUNT - i : BATCH;
+      for (int j = 0; j < n; j++) {
+        batch[j] = i + j;
+      }
+      for (int pushed = 0; pushed < n;) {
+        size_t count = spsc_push_many(ch->q, batch + pushed, n - pushed);
+        if (count == 0) {
+          sched_yield();
+        }
+        pushed += count;
+      }
+      i += n;
+    } else {
+      while (!spsc_push(ch->q, i)) {
+        sched_yield();
+      }
+      i++;
+    }
+  }
+  return NULL;
+}
+
+// Consumes COUNT values on the calling thread. Returns their sum.
+static long long consume(channel *ch) {
+  long long sum = 0;
+  int batch[BATCH];
+  for (int received = 0; received < COUNT;) {
+    size_t n = 0;
+    if (ch->locked != NULL) {
+      pthread_mutex_lock(&ch->locked->mutex);
+      if (!llist_empty(ch->locked->list)) {
+        batch[0] = llist_pop_front(ch->locked->list);
+        n = 1;
+      }
+      pthread_mutex_unlock(&ch->locked->mutex);
+    } else if (ch->batched) {
+      n = spsc_pop_many(ch->q, batch, BATCH);
+    } else {
+      n = spsc_pop(ch->q, batch);
+    }
+    if (n == 0) {
+      sched_yield();
+    }
+    for (size_t i = 0; i < n; i++) {
+      sum += batch[i];
+    }
+    received += n;
+  }
+  return sum;
+}
+
+// Runs a producer thread against a consumer on the calling thread and prints
+// the throughput.
+static void bench_throughput(const char *name, channel *ch) {
+  double start = now();
+  pthread_t producer;
+  if (pthread_create(&producer, NULL, produce, ch) != 0) {
+    fprintf(stderr, "Failed to start producer thread\n");
+    return;
+  }
+  long long sum = consume(ch);
+  pthread_join(producer, NULL);
+  double elapsed = now() - start;
+  printf("%-16s %8.2f M values/s (checksum %lld)\n", name,
+         COUNT / elapsed / 1e6, sum);
+}
+
+typedef struct ping_pong {
+  spsc *ping;
+  spsc *pong;
+} ping_pong;
+
+static void *echo(void *arg) {
+  ping_pong *pp = arg;
+  for (int i = 0; i < ROUND_TRIPS; i++) {
+    int value;
+    while (!spsc_pop(pp->ping, &value)) {
+      sched_yield();
+    }
+    while (!spsc_push(pp->pong, value)) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+// Sends values to an echoing thread and waits for each to come back. Prints
+// the average round trip time.
+static void bench_latency() {
+  ping_pong pp = {spsc_create(1), spsc_create(1)};
+  pthread_t echoer;
+  if (pthread_create(&echoer, NULL, echo, &pp) != 0) {
+    fprintf(stderr, "Failed to start echo thread\n");
+    return;
+  }
+  double start = now();
+  for (int i = 0; i < ROUND_TRIPS; i++) {
+    int value;
+    while (!spsc_push(pp.ping, i)) {
+      sched_yield();
+    }
+    while (!spsc_pop(pp.pong, &value)) {
+      sched_yield();
+    }
+  }
+  double elapsed = now() - start;
+  pthread_join(echoer, NULL);
+  printf("%-16s %8.0f ns\n", "round trip:", elapsed / ROUND_TRIPS * 1e9);
+  spsc_destroy(pp.ping);
+  spsc_destroy(pp.pong);
+}
+
+int main() {
+  locked_llist locked;
+  pthread_mutex_init(&locked.mutex, NULL);
+  locked.list = llist_create_pooled();
+  channel ch = {&locked, NULL, false};
+  bench_throughput("mutex + llist:", &ch);
+  llist_destroy(locked.list);
+  pthread_mutex_destroy(&locked.mutex);
+
+  ch = (channel){NULL, spsc_create(4096), false};
+  bench_throughput("spsc:", &ch);
+  spsc_destroy(ch.q);
+
+  ch = (channel){NULL, spsc_create(4096), true};
+  bench_throughput("spsc batched:", &ch);
+  spsc_destroy(ch.q);
+
+  bench_latency();
+}
@@ -0,0 +1,194 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/wsdeque/wsdeque.h"
+
+// Depth of the tree of tasks. Every task above depth 0 spawns two more, so
+// there are 2^(DEPTH + 1) - 1 tasks in total.
+#define DEPTH 20
+
+// Number of loop iterations of busy work done by each task.
+#define WORK 200
+
+// Largest number of threads benchmarked on any machine.
+#define MAX_THREADS 64
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Tasks are pointers to their depths, so no task needs allocating.
+static int depths[DEPTH + 1];
+
+typedef struct runner {
+  wsdeque *deques[MAX_THREADS];
+  size_t nthreads;
+  // Number of tasks not yet run. Workers stop once it reaches 0.
+  atomic_long remaining;
+  // Set if the run had to be abandoned, which also stops the workers.
+  atomic_bool failed;
+} runner;
+
+typedef struct worker {
+  runner *r;
+  size_t id;
+  long long checksum;
+} worker;
+
+static void run_task(worker *w, int depth) {
+  volatile long long sum = 0;
+  for (int i = 0; i < WORK; i++) {
+    sum += i ^ depth;
+  }
+  w->checksum += sum;
+  // A task that is not pushed would never run and `remaining` would never
+  // reach 0, so give up on the run instead
+  if (depth > 0 &&
+      (!wsdeque_push(w->r->deques[w->id], &depths[depth - 1]) ||
+       !wsdeque_push(w->r->deques[w->id], &depths[depth - 1]))) {
+    atomic_store_explicit(&w->r->failed, true, memory_order_relaxed);
+  }
+  atomic_fetch_sub_explicit(&w->r->remaining, 1, memory_order_relaxed);
+}
+
+static void *work(void *arg) {
+  worker *w = arg;
+  runner *r = w->r;
+  size_t victim = w->id;
+  while (atomic_load_explicit(&r->remaining, memory_order_relaxed) > 0 &&
+         !atomic_load_explicit(&r->failed, memory_order_relaxed)) {
+    void *task;
+    if (wsdeque_pop(r->deques[w->id], &task)) {
+      run_task(w, *(int *)task);
+      continue;
+    }
+
+    // Out of work, so try to steal from the others in turn
+    bool stolen = false;
+    for (size_t i = 1; i < r->nthreads && !stolen; i++) {
+      victim = (victim + 1) % r->nthreads;
+      if (victim != w->id && wsdeque_steal(r->deques[victim], &task)) {
+        run_task(w, *(int *)task);
+        stolen = true;
+      }
+    }
+    if (!stolen) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+// Destroys the deques of a given runner.
+static void destroy_deques(runner *r) {
+  for (size_t i = 0; i < r->nthreads; i++) {
+    wsdeque_destroy(r->deques[i]);
+  }
+}
+
+// Runs the whole tree of tasks on `nthreads` threads, starting from a single
+// task on the first one. Returns the time taken in seconds, or a negative
+// number if a deque could not be created or grown or a thread failed to
+// start.
+static double bench(size_t nthreads, long long *checksum) {
+  runner r;
+  r.nthreads = nthreads;
+  atomic_init(&r.remaining, (2L << DEPTH) - 1);
+  atomic_init(&r.failed, false);
+  bool created = true;
+  for (size_t i = 0; i < nthreads; i++) {
+    r.deques[i] = wsdeque_create(64);
+    created &= r.deques[i] != NULL;
+  }
+  if (!created || !wsdeque_push(r.deques[0], &depths[DEPTH])) {
+    fprintf(stderr, "Failed to create deques\n");
+    destroy_deques(&r);
+    return -1;
+  }
+
+  worker workers[MAX_THREADS];
+  pthread_t threads[MAX_THREADS];
+  // Thread 0 is this one
+  size_t started = 1;
+  double start = now();
+  workers[0] = (worker){&r, 0, 0};
+  for (size_t i = 1; i < nthreads; i++) {
+    workers[i] = (worker){&r, i, 0};
+    if (pthread_create(&threads[i], NULL, work, &workers[i]) != 0) {
+      fprintf(stderr, "Failed to start worker thread\n");
+      atomic_store_explicit(&r.failed, true, memory_order_relaxed);
+      break;
+    }
+    started++;
+  }
+  work(&workers[0]);
+  for (size_t i = 1; i < started; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  double elapsed = now() - start;
+
+  for (size_t i = 0; i < started; i++) {
+    *checksum += workers[i].checksum;
+  }
+  destroy_deques(&r);
+  if (atomic_load_explicit(&r.failed, memory_order_relaxed)) {
+    return -1;
+  }
+  return elapsed;
+}
+
+int main() {
+  for (int i = 0; i <= DEPTH; i++) {
+    depths[i] = i;
+  }
+
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t max_threads = cores > 1 ? cores : 1;
+  if (max_threads > MAX_THREADS) {
+    max_threads = MAX_THREADS;
+  }
+
+  double single_time = 0;
+  for (size_t nthreads = 1; nthreads <= max_threads; nthreads++) {
+    long long checksum = 0;
+    double elapsed = bench(nthreads, &checksum);
+    if (elapsed < 0) {
+      fprintf(stderr, "Run with %lu threads failed\n", nthreads);
+      return 1;
+    }
+    if (nthreads == 1) {
+      single_time = elapsed;
+    }
+    printf("%2lu threads: %.3f s (%.2fx, checksum %lld)\n", nthreads, elapsed,
+           single_time / elapsed, checksum);
+  }
+}
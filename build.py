@@ -2,9 +2,84 @@
 from pathlib import Path
 from globuild import DependencyGraph
 
+ALLOCATOR_OBJECTS = ["arena.o", "fixed_pool.o"]
+VECTOR_OBJECTS = ["vector.o", "vector_search.o", "vector_sort.o"]
+LLIST_OBJECTS = ["llist.o"]
+ULIST_OBJECTS = ["ulist.o"]
+CLIST_OBJECTS = ["clist.o"]
+DEQUE_OBJECTS = ["deque.o"]
+SPSC_OBJECTS = ["spsc.o"]
+WSDEQUE_OBJECTS = ["wsdeque.o"]
+HASHMAP_OBJECTS = ["hashmap.o"]
+INTSET_OBJECTS = ["intset.o"]
+BTREE_OBJECTS = ["btree.o"]
+PQUEUE_OBJECTS = ["pqueue.o"]
+SEGVECTOR_OBJECTS = ["segvector.o"]
+SORTEDSET_OBJECTS = ["sortedset.o"]
+LIBRARY_OBJECTS = [
+    *ALLOCATOR_OBJECTS,
+    *VECTOR_OBJECTS,
+    *LLIST_OBJECTS,
+    *ULIST_OBJECTS,
+    *CLIST_OBJECTS,
+    *DEQUE_OBJECTS,
+    *SPSC_OBJECTS,
+    *WSDEQUE_OBJECTS,
+    *HASHMAP_OBJECTS,
+    *INTSET_OBJECTS,
+    *BTREE_OBJECTS,
+    *PQUEUE_OBJECTS,
+    *SEGVECTOR_OBJECTS,
+    *SORTEDSET_OBJECTS,
+]
+
 dg = DependencyGraph(Path())
-dg.add_static_library("libcdatastructures.a", "vector.o", "llist.o")
-dg.add_shared_library("libcdatastructures.so", "vector.o", "llist.o")
-dg.add_executable("vectortest", "vector.o", "vectortest.c")
-dg.add_executable("llisttest", "llist.o", "llisttest.c")
+dg.add_static_library("libcdatastructures.a", *LIBRARY_OBJECTS)
+dg.add_shared_library("libcdatastructures.so", *LIBRARY_OBJECTS)
+dg.add_executable("vectortest", *VECTOR_OBJECTS, "vectortest.c")
+dg.add_executable("llisttest", *LLIST_OBJECTS, "llisttest.c")
+dg.add_executable("ulisttest", *ULIST_OBJECTS, "ulisttest.c")
+dg.add_executable("clisttest", *CLIST_OBJECTS, "clisttest.c")
+dg.add_executable("ilisttest", "ilisttest.c")
+dg.add_executable("dequetest", *DEQUE_OBJECTS, *VECTOR_OBJECTS, "dequetest.c")
+dg.add_executable("spsctest", *SPSC_OBJECTS, *VECTOR_OBJECTS, "spsctest.c")
+dg.add_executable("wsdequetest", *WSDEQUE_OBJECTS, "wsdequetest.c")
+dg.add_executable("hashmaptest", *HASHMAP_OBJECTS, "hashmaptest.c")
+dg.add_executable("intsettest", *INTSET_OBJECTS, *VECTOR_OBJECTS, "intsettest.c")
+dg.add_executable("btreetest", *BTREE_OBJECTS, *VECTOR_OBJECTS, "btreetest.c")
+dg.add_executable("pqueuetest", *PQUEUE_OBJECTS, *VECTOR_OBJECTS, "pqueuetest.c")
+dg.add_executable(
+    "allocatortest",
+    *ALLOCATOR_OBJECTS,
+    *VECTOR_OBJECTS,
+    *LLIST_OBJECTS,
+    "allocatortest.c",
+)
+dg.add_executable(
+    "segvectortest", *SEGVECTOR_OBJECTS, *VECTOR_OBJECTS, "segvectortest.c"
+)
+dg.add_executable(
+    "sortedsettest", *SORTEDSET_OBJECTS, *VECTOR_OBJECTS, "sortedsettest.c"
+)
+dg.add_executable("llistbench", *LLIST_OBJECTS, "llistbench.c")
+dg.add_executable(
+    "spscbench", *SPSC_OBJECTS, *VECTOR_OBJECTS, *LLIST_OBJECTS, "spscbench.c"
+)
+dg.add_executable("wsdequebench", *WSDEQUE_OBJECTS, "wsdequebench.c")
+dg.add_executable(
+    "intsetbench", *INTSET_OBJECTS, *VECTOR_OBJECTS, "intsetbench.c"
+)
+dg.add_executable(
+    "btreebench",
+    *BTREE_OBJECTS,
+    *SORTEDSET_OBJECTS,
+    *VECTOR_OBJECTS,
+    "btreebench.c",
+)
+dg.add_executable(
+    "pqueuebench", *PQUEUE_OBJECTS, *VECTOR_OBJECTS, *LLIST_OBJECTS, "pqueuebench.c"
+)
+dg.add_executable(
+    "segvectorbench", *SEGVECTOR_OBJECTS, *VECTOR_OBJECTS, "segvectorbench.c"
+)
 dg.build()
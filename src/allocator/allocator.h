@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+// A memory allocator that data structures can be told to get their memory
+// from, so that their allocations can be routed to an arena, a pool or
+// anything else instead of malloc. All three functions are passed `context`
+// as their first argument, and every block is given back with the size it
+// was last allocated or re-allocated with, so that allocators need not store
+// sizes themselves. Blocks must be aligned for any type. An allocator whose
+// functions are all NULL uses malloc, realloc and free, which is what
+// allocator_default gives.
+typedef struct allocator {
+  // Allocates a block of `size` bytes. Returns NULL on failure.
+  void *(*allocate)(void *context, size_t size);
+
+  // Resizes a block of `old_size` bytes to `new_size` bytes, keeping the
+  // contents up to the smaller of the two sizes. The block may move. Returns
+  // NULL on failure, in which case the block is left as it was.
+  void *(*reallocate)(void *context, void *block, size_t old_size,
+                      size_t new_size);
+
+  // Gives back a block of `size` bytes.
+  void (*deallocate)(void *context, void *block, size_t size);
+
+  void *context;
+} allocator;
+
+// Gets the allocator used by data structures that are not given one
+// explicitly, which simply calls malloc, realloc and free.
+static inline allocator allocator_default() {
+  allocator a = {
+      .allocate = NULL,
+      .reallocate = NULL,
+      .deallocate = NULL,
+      .context = NULL,
+  };
+  return a;
+}
+
+// Checks that a given allocator is not NULL and has either all or none of its
+// functions.
+static inline bool allocator_ok(const allocator *a) {
+  return a != NULL &&
+         (a->allocate != NULL) == (a->reallocate != NULL) &&
+         (a->allocate != NULL) == (a->deallocate != NULL);
+}
+
+// Checks that two given allocators are the same, so that blocks allocated by
+// one can be given back to the other.
+static inline bool allocator_equal(const allocator *a, const allocator *b) {
+  return a->allocate == b->allocate && a->reallocate == b->reallocate &&
+         a->deallocate == b->deallocate && a->context == b->context;
+}
+
+// The following functions call the corresponding function of a given
+// allocator, or malloc, realloc and free if it has none.
+
+static inline void *allocator_allocate(const allocator *a, size_t size) {
+  return a->allocate != NULL ? a->allocate(a->context, size) : malloc(size);
+}
+
+static inline void *allocator_reallocate(const allocator *a, void *block,
+                                         size_t old_size, size_t new_size) {
+  return a->reallocate != NULL
+             ? a->reallocate(a->context, block, old_size, new_size)
+             : realloc(block, new_size);
+}
+
+static inline void allocator_deallocate(const allocator *a, void *block,
+                                        size_t size) {
+  if (a->deallocate != NULL) {
+    a->deallocate(a->context, block, size);
+  } else {
+    free(block);
+  }
+}
+
+#endif
@@ -0,0 +1,212 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "arena.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Alignment of every allocation.
+#define ALIGNMENT (alignof(max_align_t))
+
+typedef struct block {
+  struct block *next;
+  size_t size;
+  max_align_t data[];
+} block;
+
+typedef struct arena {
+  // All blocks of the arena, newest first. Allocations are bumped out of the
+  // newest block, except for oversized ones which get a block of their own
+  // behind it.
+  block *blocks;
+  size_t block_size;
+  // Number of bytes handed out from the newest block.
+  size_t used;
+  // Offset of the most recent allocation in the newest block, or SIZE_MAX if
+  // it can not be freed or grown in place.
+  size_t last;
+  // Number of bytes handed out from all blocks.
+  size_t total;
+} arena;
+
+static char *block_data(block *b) {
+  return (char *)b->data;
+}
+
+// Rounds a given size up to ALIGNMENT. Returns 0 if that would wrap.
+static size_t align_up(size_t size) {
+  if (size > SIZE_MAX - (ALIGNMENT - 1)) {
+    return 0;
+  }
+  return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+static block *block_create(size_t size) {
+  if (size > SIZE_MAX - sizeof(block)) {
+    return NULL;
+  }
+  block *b = malloc(sizeof(block) + size);
+  if (b == NULL) {
+    return NULL;
+  }
+  b->next = NULL;
+  b->size = size;
+  return b;
+}
+
+static void *arena_allocate(void *context, size_t size) {
+  arena *a = context;
+  size_t aligned = align_up(size > 0 ? size : 1);
+  if (aligned == 0) {
+    return NULL;
+  }
+
+  if (a->blocks != NULL && aligned <= a->blocks->size - a->used) {
+    a->last = a->used;
+    a->used += aligned;
+    a->total += aligned;
+    return block_data(a->blocks) + a->last;
+  }
+
+  if (aligned > a->block_size && a->blocks != NULL) {
+    // Keep bumping out of the newest block afterwards
+    block *b = block_create(aligned);
+    if (b == NULL) {
+      return NULL;
+    }
+    b->next = a->blocks->next;
+    a->blocks->next = b;
+    a->total += aligned;
+    return block_data(b);
+  }
+
+  block *b = block_create(aligned > a->block_size ? aligned : a->block_size);
+  if (b == NULL) {
+    return NULL;
+  }
+  b->next = a->blocks;
+  a->blocks = b;
+  a->used = aligned;
+  a->last = 0;
+  a->total += aligned;
+  return block_data(b);
+}
+
+static bool is_last(arena *a, void *pointer) {
+  return a->last != SIZE_MAX && pointer == block_data(a->blocks) + a->last;
+}
+
+static void *arena_reallocate(void *context, void *pointer, size_t old_size,
+                              size_t new_size) {
+  arena *a = context;
+  if (is_last(a, pointer)) {
+    size_t aligned = align_up(new_size > 0 ? new_size : 1);
+    if (aligned != 0 && aligned <= a->blocks->size - a->last) {
+      a->total = a->total - (a->used - a->last) + aligned;
+      a->used = a->last + aligned;
+      return pointer;
+    }
+  }
+  if (new_size <= old_size) {
+    return pointer;
+  }
+
+  void *new_pointer = arena_allocate(a, new_size);
+  if (new_pointer != NULL) {
+    memcpy(new_pointer, pointer, old_size);
+  }
+  return new_pointer;
+}
+
+static void arena_deallocate(void *context, void *pointer, size_t size) {
+  (void)size;
+  arena *a = context;
+  if (is_last(a, pointer)) {
+    a->total -= a->used - a->last;
+    a->used = a->last;
+    a->last = SIZE_MAX;
+  }
+}
+
+arena *arena_create(size_t block_size) {
+  assert(block_size > 0 &&
+         "Failed to create arena because block size was 0");
+
+  arena *a = malloc(sizeof(arena));
+  if (a == NULL) {
+    return NULL;
+  }
+  a->blocks = NULL;
+  a->block_size = block_size;
+  a->used = 0;
+  a->last = SIZE_MAX;
+  a->total = 0;
+  return a;
+}
+
+void arena_destroy(arena *a) {
+  if (a != NULL) {
+    arena_reset(a);
+    free(a->blocks);
+    free(a);
+  }
+}
+
+void arena_reset(arena *a) {
+  assert(a != NULL && "Failed to reset arena because pointer was NULL");
+
+  if (a->blocks != NULL) {
+    block *b = a->blocks->next;
+    while (b != NULL) {
+      block *tmp = b;
+      b = b->next;
+      free(tmp);
+    }
+    a->blocks->next = NULL;
+  }
+  a->used = 0;
+  a->last = SIZE_MAX;
+  a->total = 0;
+}
+
+size_t arena_used(arena *a) {
+  assert(a != NULL &&
+         "Failed to get used bytes of arena because pointer was NULL");
+  return a->total;
+}
+
+allocator arena_allocator(arena *a) {
+  assert(a != NULL &&
+         "Failed to get allocator of arena because pointer was NULL");
+
+  allocator result = {
+      .allocate = arena_allocate,
+      .reallocate = arena_reallocate,
+      .deallocate = arena_deallocate,
+      .context = a,
+  };
+  return result;
+}
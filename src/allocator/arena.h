@@ -0,0 +1,63 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#include "allocator.h"
+
+// A bump allocator. Memory is carved out of large blocks by moving an offset
+// forward, and individual allocations are never really freed: everything is
+// released at once by resetting or destroying the arena. This makes it a good
+// fit for data structures that live as long as a single request or frame,
+// which can then be thrown away in O(1) instead of being destroyed piece by
+// piece. Only the most recent allocation can be freed or grown in place.
+typedef struct arena arena;
+
+// Creates a new, empty arena that allocates memory in blocks of `block_size`
+// bytes. Allocations larger than that get a block of their own. If there is
+// any allocation errors, then NULL is returned. `block_size` must not be 0.
+// When an arena is no longer needed, it should be freed by calling
+// arena_destroy.
+arena *arena_create(size_t block_size);
+
+// Destroys a given arena, freeing all memory allocated from it. Does nothing
+// if `a` is NULL.
+void arena_destroy(arena *a);
+
+// Releases all memory allocated from a given arena so that it can be reused.
+// The newest block is kept, so an arena that is reset after every request
+// stops calling malloc once it has warmed up. `a` must not be NULL.
+void arena_reset(arena *a);
+
+// Gets the number of bytes handed out by a given arena since it was created
+// or last reset, including padding. `a` must not be NULL.
+size_t arena_used(arena *a);
+
+// Gets an allocator that allocates from a given arena. Freeing through it
+// does nothing except for the most recent allocation. The arena must outlive
+// everything allocated through it. `a` must not be NULL.
+allocator arena_allocator(arena *a);
+
+#endif
@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fixed_pool.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Alignment of every object.
+#define ALIGNMENT (alignof(max_align_t))
+
+// A chunk of objects allocated in one go.
+typedef struct slab {
+  struct slab *next;
+  max_align_t objects[];
+} slab;
+
+// An object that has been given back to the pool.
+typedef struct free_object {
+  struct free_object *next;
+} free_object;
+
+typedef struct fixed_pool {
+  // All slabs of the pool, newest first. Objects are handed out from the
+  // newest slab, and only when it is used up is a new one allocated.
+  slab *slabs;
+  size_t object_size;
+  size_t objects_per_slab;
+  // Number of objects handed out from the newest slab.
+  size_t used;
+  free_object *free_objects;
+} fixed_pool;
+
+static void *fixed_pool_allocate(void *context, size_t size) {
+  fixed_pool *pool = context;
+  if (size > pool->object_size) {
+    return NULL;
+  }
+
+  if (pool->free_objects != NULL) {
+    free_object *object = pool->free_objects;
+    pool->free_objects = object->next;
+    return object;
+  }
+
+  if (pool->slabs == NULL || pool->used == pool->objects_per_slab) {
+    slab *s =
+        malloc(sizeof(slab) + pool->objects_per_slab * pool->object_size);
+    if (s == NULL) {
+      return NULL;
+    }
+    s->next = pool->slabs;
+    pool->slabs = s;
+    pool->used = 0;
+  }
+  return (char *)pool->slabs->objects + pool->used++ * pool->object_size;
+}
+
+static void *fixed_pool_reallocate(void *context, void *pointer,
+                                   size_t old_size, size_t new_size) {
+  (void)old_size;
+  fixed_pool *pool = context;
+  return new_size <= pool->object_size ? pointer : NULL;
+}
+
+static void fixed_pool_deallocate(void *context, void *pointer, size_t size) {
+  (void)size;
+  fixed_pool *pool = context;
+  free_object *object = pointer;
+  object->next = pool->free_objects;
+  pool->free_objects = object;
+}
+
+fixed_pool *fixed_pool_create(size_t object_size, size_t objects_per_slab) {
+  assert(object_size > 0 &&
+         "Failed to create fixed pool because object size was 0");
+  assert(objects_per_slab > 0 &&
+         "Failed to create fixed pool because slab size was 0");
+  assert(object_size <= SIZE_MAX - ALIGNMENT &&
+         (object_size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT <=
+             (SIZE_MAX - sizeof(slab)) / objects_per_slab &&
+         "Failed to create fixed pool because slab size would cause an "
+         "unsigned integer wrap");
+
+  fixed_pool *pool = malloc(sizeof(fixed_pool));
+  if (pool == NULL) {
+    return NULL;
+  }
+  pool->slabs = NULL;
+  pool->object_size = (object_size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  pool->objects_per_slab = objects_per_slab;
+  pool->used = 0;
+  pool->free_objects = NULL;
+  return pool;
+}
+
+void fixed_pool_destroy(fixed_pool *pool) {
+  if (pool != NULL) {
+    fixed_pool_reset(pool);
+    free(pool->slabs);
+    free(pool);
+  }
+}
+
+void fixed_pool_reset(fixed_pool *pool) {
+  assert(pool != NULL &&
+         "Failed to reset fixed pool because pointer was NULL");
+
+  if (pool->slabs != NULL) {
+    slab *s = pool->slabs->next;
+    while (s != NULL) {
+      slab *tmp = s;
+      s = s->next;
+      free(tmp);
+    }
+    pool->slabs->next = NULL;
+  }
+  pool->used = 0;
+  pool->free_objects = NULL;
+}
+
+size_t fixed_pool_object_size(fixed_pool *pool) {
+  assert(pool != NULL &&
+         "Failed to get object size of fixed pool because pointer was NULL");
+  return pool->object_size;
+}
+
+allocator fixed_pool_allocator(fixed_pool *pool) {
+  assert(pool != NULL &&
+         "Failed to get allocator of fixed pool because pointer was NULL");
+
+  allocator result = {
+      .allocate = fixed_pool_allocate,
+      .reallocate = fixed_pool_reallocate,
+      .deallocate = fixed_pool_deallocate,
+      .context = pool,
+  };
+  return result;
+}
@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef FIXED_POOL_H
+#define FIXED_POOL_H
+
+#include <stddef.h>
+
+#include "allocator.h"
+
+// An allocator for objects of a single size. Objects are carved out of large
+// slabs and recycled through a free list, so allocating and freeing them is
+// O(1) and never calls malloc once the pool has warmed up. It works like
+// llist_pool, but for any data structure that allocates fixed-size nodes.
+typedef struct fixed_pool fixed_pool;
+
+// Creates a new, empty pool of objects of `object_size` bytes, allocated
+// `objects_per_slab` at a time. If there is any allocation errors, then NULL
+// is returned. Neither `object_size` nor `objects_per_slab` may be 0 and a
+// slab must not be so large that its size would cause an unsigned integer
+// wrap. When a pool is no longer needed, it should be freed by calling
+// fixed_pool_destroy.
+fixed_pool *fixed_pool_create(size_t object_size, size_t objects_per_slab);
+
+// Destroys a given pool, freeing all objects allocated from it. Does nothing
+// if `pool` is NULL.
+void fixed_pool_destroy(fixed_pool *pool);
+
+// Frees every object allocated from a given pool at once. The newest slab is
+// kept for reuse. `pool` must not be NULL.
+void fixed_pool_reset(fixed_pool *pool);
+
+// Gets the size of the objects of a given pool, which is the size it was
+// created with rounded up for alignment. `pool` must not be NULL.
+size_t fixed_pool_object_size(fixed_pool *pool);
+
+// Gets an allocator that allocates from a given pool. Allocations larger than
+// the object size of the pool fail, and so does growing an object beyond it.
+// The pool must outlive everything allocated through it. `pool` must not be
+// NULL.
+allocator fixed_pool_allocator(fixed_pool *pool);
+
+#endif
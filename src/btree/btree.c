@@ -0,0 +1,787 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "btree.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector_inline.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// Largest number of keys in a node.
+#define NODE_KEYS 32
+
+// Smallest number of keys in any node but the root. Merging two nodes this
+// small, plus a separator key, still fits in one node.
+#define MIN_KEYS (NODE_KEYS / 2 - 1)
+
+// Keys past the length of a node are set to this, so that searches can
+// compare all NODE_KEYS keys without looking at the length.
+#define PADDING INT_MAX
+
+// The part shared by leaves and inner nodes.
+typedef struct node {
+  uint32_t length;
+  bool leaf;
+  int keys[NODE_KEYS];
+} node;
+
+typedef struct btree_leaf {
+  node base;
+  int values[NODE_KEYS];
+  struct btree_leaf *next;
+  struct btree_leaf *previous;
+} leaf;
+
+// Holds `length + 1` children. All keys in children[i] are less than keys[i],
+// which is less than or equal to all keys in children[i + 1].
+typedef struct inner {
+  node base;
+  node *children[NODE_KEYS + 1];
+} inner;
+
+// Node search kernels. Each takes all NODE_KEYS keys of a node.
+typedef struct kernels {
+  uint32_t (*count_less)(const int *keys, int key);
+  uint32_t (*count_less_equal)(const int *keys, int key);
+} kernels;
+
+typedef struct btree {
+  node *root;
+  leaf *first;
+  leaf *last;
+  size_t length;
+  const kernels *k;
+} btree;
+
+static uint32_t count_less_scalar(const int *keys, int key) {
+  uint32_t count = 0;
+  for (size_t i = 0; i < NODE_KEYS; i++) {
+    count += keys[i] < key;
+  }
+  return count;
+}
+
+static uint32_t count_less_equal_scalar(const int *keys, int key) {
+  uint32_t count = 0;
+  for (size_t i = 0; i < NODE_KEYS; i++) {
+    count += keys[i] <= key;
+  }
+  return count;
+}
+
+static const kernels SCALAR_KERNELS = {
+    .count_less = count_less_scalar,
+    .count_less_equal = count_less_equal_scalar,
+};
+
+#ifdef CPU_X86
+
+__attribute__((target("avx2,popcnt"))) static uint32_t
+count_less_avx2(const int *keys, int key) {
+  __m256i k = _mm256_set1_epi32(key);
+  uint32_t count = 0;
+  for (size_t i = 0; i < NODE_KEYS; i += 8) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(keys + i));
+    __m256i less = _mm256_cmpgt_epi32(k, v);
+    count += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(less)));
+  }
+  return count;
+}
+
+__attribute__((target("avx2,popcnt"))) static uint32_t
+count_less_equal_avx2(const int *keys, int key) {
+  __m256i k = _mm256_set1_epi32(key);
+  uint32_t count = 0;
+  for (size_t i = 0; i < NODE_KEYS; i += 8) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(keys + i));
+    __m256i greater = _mm256_cmpgt_epi32(v, k);
+    count += 8 - _mm_popcnt_u32(
+                     _mm256_movemask_ps(_mm256_castsi256_ps(greater)));
+  }
+  return count;
+}
+
+static const kernels AVX2_KERNELS = {
+    .count_less = count_less_avx2,
+    .count_less_equal = count_less_equal_avx2,
+};
+
+#endif
+
+// Gets the fastest set of kernels available at a given CPU level.
+static const kernels *kernels_for(cpu_level level) {
+#ifdef CPU_X86
+  if (level >= CPU_LEVEL_AVX2) {
+    return &AVX2_KERNELS;
+  }
+#endif
+  (void)level;
+  return &SCALAR_KERNELS;
+}
+
+// New trees take the kernels in use when they are created
+CPU_DEFINE_KERNELS(kernels, kernels_for)
+
+// Gets the index of the first key of a node that is not less than `key`.
+static uint32_t lower_bound(btree *tree, node *n, int key) {
+  return tree->k->count_less(n->keys, key);
+}
+
+// Gets the index of the child of an inner node that may hold `key`. Padding
+// compares less than or equal to INT_MAX, so the count is capped.
+static uint32_t child_index(btree *tree, node *n, int key) {
+  uint32_t i = tree->k->count_less_equal(n->keys, key);
+  return i < n->length ? i : n->length;
+}
+
+static leaf *as_leaf(node *n) { return (leaf *)n; }
+
+static inner *as_inner(node *n) { return (inner *)n; }
+
+static void pad(node *n) {
+  for (size_t i = n->length; i < NODE_KEYS; i++) {
+    n->keys[i] = PADDING;
+  }
+}
+
+static void *alloc_node(size_t size) {
+  size_t rounded = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+  return aligned_alloc(CACHE_LINE, rounded);
+}
+
+static leaf *leaf_create() {
+  leaf *l = alloc_node(sizeof(leaf));
+  if (l == NULL) {
+    return NULL;
+  }
+  l->base.length = 0;
+  l->base.leaf = true;
+  l->next = NULL;
+  l->previous = NULL;
+  pad(&l->base);
+  return l;
+}
+
+static inner *inner_create() {
+  inner *in = alloc_node(sizeof(inner));
+  if (in == NULL) {
+    return NULL;
+  }
+  in->base.length = 0;
+  in->base.leaf = false;
+  pad(&in->base);
+  return in;
+}
+
+static void node_destroy(node *n) {
+  if (!n->leaf) {
+    inner *in = as_inner(n);
+    for (size_t i = 0; i <= n->length; i++) {
+      node_destroy(in->children[i]);
+    }
+  }
+  free(n);
+}
+
+// Links leaf `l` into the leaf list right after `previous`.
+static void link_after(btree *tree, leaf *previous, leaf *l) {
+  l->previous = previous;
+  l->next = previous->next;
+  if (previous->next != NULL) {
+    previous->next->previous = l;
+  } else {
+    tree->last = l;
+  }
+  previous->next = l;
+}
+
+static void unlink_leaf(btree *tree, leaf *l) {
+  if (l->previous != NULL) {
+    l->previous->next = l->next;
+  } else {
+    tree->first = l->next;
+  }
+  if (l->next != NULL) {
+    l->next->previous = l->previous;
+  } else {
+    tree->last = l->previous;
+  }
+}
+
+// Inserts a key and a child to its right into an inner node that is not full.
+static void inner_insert(inner *in, uint32_t i, int key, node *child) {
+  node *n = &in->base;
+  memmove(n->keys + i + 1, n->keys + i, (n->length - i) * sizeof(int));
+  memmove(in->children + i + 2, in->children + i + 1,
+          (n->length - i) * sizeof(node *));
+  n->keys[i] = key;
+  in->children[i + 1] = child;
+  n->length++;
+}
+
+// Removes key i and the child to its right from an inner node.
+static void inner_remove(inner *in, uint32_t i) {
+  node *n = &in->base;
+  memmove(n->keys + i, n->keys + i + 1, (n->length - i - 1) * sizeof(int));
+  memmove(in->children + i + 1, in->children + i + 2,
+          (n->length - i - 1) * sizeof(node *));
+  n->length--;
+  n->keys[n->length] = PADDING;
+}
+
+// Splits the full child i of a given inner node in two, moving the upper half
+// into a new node to its right. Returns false if allocation fails, in which
+// case nothing changes.
+static bool split_child(btree *tree, inner *parent, uint32_t i) {
+  node *child = parent->children[i];
+  uint32_t half = NODE_KEYS / 2;
+  int separator;
+  node *right;
+  if (child->leaf) {
+    leaf *l = as_leaf(child);
+    leaf *r = leaf_create();
+    if (r == NULL) {
+      return false;
+    }
+    r->base.length = NODE_KEYS - half;
+    memcpy(r->base.keys, l->base.keys + half, r->base.length * sizeof(int));
+    memcpy(r->values, l->values + half, r->base.length * sizeof(int));
+    l->base.length = half;
+    link_after(tree, l, r);
+    separator = r->base.keys[0];
+    right = &r->base;
+  } else {
+    // The middle key moves up instead of being copied
+    inner *in = as_inner(child);
+    inner *r = inner_create();
+    if (r == NULL) {
+      return false;
+    }
+    separator = in->base.keys[half];
+    r->base.length = NODE_KEYS - half - 1;
+    memcpy(r->base.keys, in->base.keys + half + 1,
+           r->base.length * sizeof(int));
+    memcpy(r->children, in->children + half + 1,
+           (r->base.length + 1) * sizeof(node *));
+    in->base.length = half;
+    right = &r->base;
+  }
+  pad(child);
+  pad(right);
+  inner_insert(parent, i, separator, right);
+  return true;
+}
+
+btree *btree_create() {
+  btree *tree = malloc(sizeof(btree));
+  if (tree == NULL) {
+    return NULL;
+  }
+  leaf *root = leaf_create();
+  if (root == NULL) {
+    free(tree);
+    return NULL;
+  }
+  tree->root = &root->base;
+  tree->first = root;
+  tree->last = root;
+  tree->length = 0;
+  tree->k = select_kernels();
+  return tree;
+}
+
+// Gets the smallest key under a given node.
+static int min_key(node *n) {
+  while (!n->leaf) {
+    n = as_inner(n)->children[0];
+  }
+  return n->keys[0];
+}
+
+btree *btree_create_from_sorted(const int *keys, const int *values,
+                                size_t length) {
+  assert(((keys != NULL && values != NULL) || length == 0) &&
+         "Failed to create B+tree from sorted entries because at least one "
+         "of the array pointers was NULL");
+
+  btree *tree = btree_create();
+  if (tree == NULL || length == 0) {
+    return tree;
+  }
+
+  // Spread the entries evenly over as few leaves as possible, which leaves
+  // every leaf at least half full
+  size_t count = (length + NODE_KEYS - 1) / NODE_KEYS;
+  node **level = malloc(count * sizeof(node *));
+  if (level == NULL) {
+    btree_destroy(tree);
+    return NULL;
+  }
+  leaf *previous = tree->first;
+  size_t start = 0;
+  for (size_t i = 0; i < count; i++) {
+    leaf *l = i == 0 ? tree->first : leaf_create();
+    if (l == NULL) {
+      for (size_t j = 0; j < i; j++) {
+        node_destroy(level[j]);
+      }
+      free(level);
+      free(tree);
+      return NULL;
+    }
+    size_t end = length * (i + 1) / count;
+    l->base.length = end - start;
+    memcpy(l->base.keys, keys + start, l->base.length * sizeof(int));
+    memcpy(l->values, values + start, l->base.length * sizeof(int));
+    pad(&l->base);
+    if (i > 0) {
+      link_after(tree, previous, l);
+    }
+    previous = l;
+    level[i] = &l->base;
+    start = end;
+  }
+
+  // Build each level of inner nodes on top of the one below, in place
+  while (count > 1) {
+    size_t parents = (count + NODE_KEYS) / (NODE_KEYS + 1);
+    start = 0;
+    for (size_t i = 0; i < parents; i++) {
+      inner *in = inner_create();
+      if (in == NULL) {
+        // Free the parents made so far, which free their children, and the
+        // nodes that have no parent yet
+        for (size_t j = 0; j < i; j++) {
+          node_destroy(level[j]);
+        }
+        for (size_t j = start; j < count; j++) {
+          node_destroy(level[j]);
+        }
+        free(level);
+        free(tree);
+        return NULL;
+      }
+      size_t end = count * (i + 1) / parents;
+      in->children[0] = level[start];
+      for (size_t j = start + 1; j < end; j++) {
+        in->base.keys[j - start - 1] = min_key(level[j]);
+        in->children[j - start] = level[j];
+      }
+      in->base.length = end - start - 1;
+      pad(&in->base);
+      level[i] = &in->base;
+      start = end;
+    }
+    count = parents;
+  }
+  tree->root = level[0];
+  tree->length = length;
+  free(level);
+  return tree;
+}
+
+btree *btree_create_from_vector(vector *keys, vector *values) {
+  assert(keys != NULL &&
+         "Failed to create B+tree from vector because key vector pointer was "
+         "NULL");
+  assert((values == NULL || vector_length(values) == vector_length(keys)) &&
+         "Failed to create B+tree from vector because the vectors had "
+         "different lengths");
+  assert(vector_is_sorted(keys) &&
+         "Failed to create B+tree from vector because keys were not sorted");
+
+  size_t length = vector_length(keys);
+  int *unique_keys = malloc((length > 0 ? length : 1) * sizeof(int));
+  int *unique_values = malloc((length > 0 ? length : 1) * sizeof(int));
+  if (unique_keys == NULL || unique_values == NULL) {
+    free(unique_keys);
+    free(unique_values);
+    return NULL;
+  }
+
+  size_t unique = 0;
+  for (size_t i = 0; i < length; i++) {
+    int key = vector_data(keys)[i];
+    int value = values != NULL ? vector_data(values)[i] : 0;
+    if (unique > 0 && unique_keys[unique - 1] == key) {
+      unique_values[unique - 1] = value;
+    } else {
+      unique_keys[unique] = key;
+      unique_values[unique] = value;
+      unique++;
+    }
+  }
+
+  btree *tree = btree_create_from_sorted(unique_keys, unique_values, unique);
+  free(unique_keys);
+  free(unique_values);
+  return tree;
+}
+
+void btree_destroy(btree *tree) {
+  if (tree != NULL) {
+    if (tree->root != NULL) {
+      node_destroy(tree->root);
+    }
+    free(tree);
+  }
+}
+
+size_t btree_length(btree *tree) {
+  assert(tree != NULL &&
+         "Failed to get length of B+tree because pointer was NULL");
+  return tree->length;
+}
+
+// Finds the leaf that may hold a given key.
+static leaf *find_leaf(btree *tree, int key) {
+  node *n = tree->root;
+  while (!n->leaf) {
+    n = as_inner(n)->children[child_index(tree, n, key)];
+  }
+  return as_leaf(n);
+}
+
+bool btree_put(btree *tree, int key, int value) {
+  assert(tree != NULL &&
+         "Failed to put entry into B+tree because pointer was NULL");
+
+  // Split full nodes on the way down, so that there is always room for a
+  // separator key from below
+  if (tree->root->length == NODE_KEYS) {
+    inner *root = inner_create();
+    if (root == NULL) {
+      return false;
+    }
+    root->children[0] = tree->root;
+    if (!split_child(tree, root, 0)) {
+      free(root);
+      return false;
+    }
+    tree->root = &root->base;
+  }
+
+  node *n = tree->root;
+  while (!n->leaf) {
+    inner *in = as_inner(n);
+    uint32_t i = child_index(tree, n, key);
+    if (in->children[i]->length == NODE_KEYS) {
+      if (!split_child(tree, in, i)) {
+        return false;
+      }
+      i += key >= n->keys[i];
+    }
+    n = in->children[i];
+  }
+
+  leaf *l = as_leaf(n);
+  uint32_t i = lower_bound(tree, n, key);
+  if (i < n->length && n->keys[i] == key) {
+    l->values[i] = value;
+    return true;
+  }
+  memmove(n->keys + i + 1, n->keys + i, (n->length - i) * sizeof(int));
+  memmove(l->values + i + 1, l->values + i, (n->length - i) * sizeof(int));
+  n->keys[i] = key;
+  l->values[i] = value;
+  n->length++;
+  tree->length++;
+  return true;
+}
+
+bool btree_get(btree *tree, int key, int *value) {
+  assert(tree != NULL && value != NULL &&
+         "Failed to get value from B+tree because at least one of the "
+         "pointers was NULL");
+
+  leaf *l = find_leaf(tree, key);
+  uint32_t i = lower_bound(tree, &l->base, key);
+  if (i == l->base.length || l->base.keys[i] != key) {
+    return false;
+  }
+  *value = l->values[i];
+  return true;
+}
+
+bool btree_contains(btree *tree, int key) {
+  assert(tree != NULL &&
+         "Failed to check if B+tree contains key because pointer was NULL");
+
+  leaf *l = find_leaf(tree, key);
+  uint32_t i = lower_bound(tree, &l->base, key);
+  return i < l->base.length && l->base.keys[i] == key;
+}
+
+// Moves the first entry of child i + 1 of a given inner node to the end of
+// child i.
+static void borrow_from_right(inner *parent, uint32_t i) {
+  node *child = parent->children[i];
+  node *right = parent->children[i + 1];
+  if (child->leaf) {
+    child->keys[child->length] = right->keys[0];
+    as_leaf(child)->values[child->length] = as_leaf(right)->values[0];
+    memmove(as_leaf(right)->values, as_leaf(right)->values + 1,
+            (right->length - 1) * sizeof(int));
+    memmove(right->keys, right->keys + 1, (right->length - 1) * sizeof(int));
+    right->length--;
+    parent->base.keys[i] = right->keys[0];
+  } else {
+    // Rotate through the separator
+    child->keys[child->length] = parent->base.keys[i];
+    as_inner(child)->children[child->length + 1] =
+        as_inner(right)->children[0];
+    parent->base.keys[i] = right->keys[0];
+    memmove(right->keys, right->keys + 1, (right->length - 1) * sizeof(int));
+    memmove(as_inner(right)->children, as_inner(right)->children + 1,
+            right->length * sizeof(node *));
+    right->length--;
+  }
+  child->length++;
+  pad(right);
+}
+
+// Moves the last entry of child i - 1 of a given inner node to the start of
+// child i.
+static void borrow_from_left(inner *parent, uint32_t i) {
+  node *child = parent->children[i];
+  node *left = parent->children[i - 1];
+  memmove(child->keys + 1, child->keys, child->length * sizeof(int));
+  if (child->leaf) {
+    memmove(as_leaf(child)->values + 1, as_leaf(child)->values,
+            child->length * sizeof(int));
+    child->keys[0] = left->keys[left->length - 1];
+    as_leaf(child)->values[0] = as_leaf(left)->values[left->length - 1];
+    parent->base.keys[i - 1] = child->keys[0];
+  } else {
+    // Rotate through the separator
+    memmove(as_inner(child)->children + 1, as_inner(child)->children,
+            (child->length + 1) * sizeof(node *));
+    child->keys[0] = parent->base.keys[i - 1];
+    as_inner(child)->children[0] = as_inner(left)->children[left->length];
+    parent->base.keys[i - 1] = left->keys[left->length - 1];
+  }
+  child->length++;
+  left->length--;
+  pad(left);
+}
+
+// Merges child i + 1 of a given inner node into child i and frees it.
+static void merge_children(btree *tree, inner *parent, uint32_t i) {
+  node *child = parent->children[i];
+  node *right = parent->children[i + 1];
+  if (child->leaf) {
+    memcpy(child->keys + child->length, right->keys,
+           right->length * sizeof(int));
+    memcpy(as_leaf(child)->values + child->length, as_leaf(right)->values,
+           right->length * sizeof(int));
+    child->length += right->length;
+    unlink_leaf(tree, as_leaf(right));
+  } else {
+    // The separator comes down between the two halves
+    child->keys[child->length] = parent->base.keys[i];
+    memcpy(child->keys + child->length + 1, right->keys,
+           right->length * sizeof(int));
+    memcpy(as_inner(child)->children + child->length + 1,
+           as_inner(right)->children, (right->length + 1) * sizeof(node *));
+    child->length += right->length + 1;
+  }
+  free(right);
+  inner_remove(parent, i);
+}
+
+bool btree_remove(btree *tree, int key, int *value) {
+  assert(tree != NULL &&
+         "Failed to remove entry from B+tree because pointer was NULL");
+
+  // Top up nodes that are at the minimum on the way down, so that removing
+  // from below never leaves a node too small
+  node *n = tree->root;
+  while (!n->leaf) {
+    inner *in = as_inner(n);
+    uint32_t i = child_index(tree, n, key);
+    if (in->children[i]->length <= MIN_KEYS) {
+      if (i > 0 && in->children[i - 1]->length > MIN_KEYS) {
+        borrow_from_left(in, i);
+      } else if (i < n->length && in->children[i + 1]->length > MIN_KEYS) {
+        borrow_from_right(in, i);
+      } else if (i < n->length) {
+        merge_children(tree, in, i);
+      } else {
+        merge_children(tree, in, i - 1);
+        i--;
+      }
+    }
+
+    node *child = in->children[i];
+    if (n == tree->root && n->length == 0) {
+      // The root lost its last key to a merge
+      tree->root = child;
+      free(n);
+    }
+    n = child;
+  }
+
+  leaf *l = as_leaf(n);
+  uint32_t i = lower_bound(tree, n, key);
+  if (i == n->length || n->keys[i] != key) {
+    return false;
+  }
+  if (value != NULL) {
+    *value = l->values[i];
+  }
+  memmove(n->keys + i, n->keys + i + 1, (n->length - i - 1) * sizeof(int));
+  memmove(l->values + i, l->values + i + 1,
+          (n->length - i - 1) * sizeof(int));
+  n->length--;
+  n->keys[n->length] = PADDING;
+  tree->length--;
+  return true;
+}
+
+bool btree_first(btree *tree, int *key, int *value) {
+  assert(tree != NULL && key != NULL && value != NULL &&
+         "Failed to get first entry of B+tree because at least one of the "
+         "pointers was NULL");
+
+  if (tree->length == 0) {
+    return false;
+  }
+  *key = tree->first->base.keys[0];
+  *value = tree->first->values[0];
+  return true;
+}
+
+bool btree_last(btree *tree, int *key, int *value) {
+  assert(tree != NULL && key != NULL && value != NULL &&
+         "Failed to get last entry of B+tree because at least one of the "
+         "pointers was NULL");
+
+  if (tree->length == 0) {
+    return false;
+  }
+  leaf *l = tree->last;
+  *key = l->base.keys[l->base.length - 1];
+  *value = l->values[l->base.length - 1];
+  return true;
+}
+
+// Moves an iterator past the ends of leaves, so that it is either at an entry
+// or at the end.
+static btree_iterator normalize(btree_iterator it) {
+  while (it.leaf != NULL && it.index == it.leaf->base.length) {
+    it.leaf = it.leaf->next;
+    it.index = 0;
+  }
+  return it;
+}
+
+btree_iterator btree_begin(btree *tree) {
+  assert(tree != NULL &&
+         "Failed to get iterator for B+tree because pointer was NULL");
+  return normalize((btree_iterator){tree->first, 0});
+}
+
+btree_iterator btree_lower_bound(btree *tree, int key) {
+  assert(tree != NULL &&
+         "Failed to get iterator for B+tree because pointer was NULL");
+
+  leaf *l = find_leaf(tree, key);
+  return normalize((btree_iterator){l, lower_bound(tree, &l->base, key)});
+}
+
+bool btree_iterator_next(btree_iterator *iterator, int *key, int *value) {
+  assert(iterator != NULL && key != NULL && value != NULL &&
+         "Failed to advance B+tree iterator because at least one of the "
+         "pointers was NULL");
+
+  if (iterator->leaf == NULL) {
+    return false;
+  }
+  *key = iterator->leaf->base.keys[iterator->index];
+  *value = iterator->leaf->values[iterator->index];
+  iterator->index++;
+  *iterator = normalize(*iterator);
+  return true;
+}
+
+size_t btree_range(btree *tree, int low, int high, int *keys, int *values,
+                   size_t capacity) {
+  assert(tree != NULL &&
+         "Failed to copy range of B+tree because tree pointer was NULL");
+  assert(((keys != NULL && values != NULL) || capacity == 0) &&
+         "Failed to copy range of B+tree because at least one of the array "
+         "pointers was NULL");
+
+  if (low > high) {
+    return 0;
+  }
+
+  // Copy whole stretches of leaves at a time
+  btree_iterator it = btree_lower_bound(tree, low);
+  size_t count = 0;
+  while (it.leaf != NULL && count < capacity) {
+    node *n = &it.leaf->base;
+    uint32_t end = n->length;
+    if (n->keys[end - 1] > high) {
+      end = high == INT_MAX ? end : lower_bound(tree, n, high + 1);
+    }
+    size_t n_copied = end - it.index;
+    if (n_copied > capacity - count) {
+      n_copied = capacity - count;
+    }
+    memcpy(keys + count, n->keys + it.index, n_copied * sizeof(int));
+    memcpy(values + count, it.leaf->values + it.index, n_copied * sizeof(int));
+    count += n_copied;
+    if (end < n->length) {
+      break;
+    }
+    it.leaf = it.leaf->next;
+    it.index = 0;
+  }
+  return count;
+}
+
+void btree_print(btree *tree) {
+  assert(tree != NULL && "Failed to print B+tree because pointer was NULL");
+
+  printf("{ ");
+  bool first = true;
+  for (leaf *l = tree->first; l != NULL; l = l->next) {
+    for (uint32_t i = 0; i < l->base.length; i++) {
+      printf(first ? "%d: %d" : ", %d: %d", l->base.keys[i], l->values[i]);
+      first = false;
+    }
+  }
+  printf(" }\n");
+}
+
+bool btree_force_kernels(cpu_level level) { return force_kernels(level); }
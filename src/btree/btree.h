@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector.h"
+
+// An ordered map from ints to ints implemented as a B+tree. Every node holds
+// up to 32 keys in a few cache lines, so that a lookup in a tree of millions
+// of entries visits only four or five nodes, and keys within a node are
+// searched with AVX2 where available. Entries live in the leaves, which are
+// linked in key order, so range scans walk leaf to leaf without going back up
+// the tree. To use the tree as an ordered set, ignore the values.
+typedef struct btree btree;
+
+struct btree_leaf;
+
+// A position in a B+tree: either at one of its entries or at the end, past
+// the last entry. Modifying the tree invalidates all iterators. The fields
+// are for internal use only.
+typedef struct btree_iterator {
+  struct btree_leaf *leaf;
+  size_t index;
+} btree_iterator;
+
+// Creates a new, empty tree. If there is any allocation errors, then NULL is
+// returned. When a tree created using this function is no longer needed, it
+// should be freed by calling the btree_destroy function to avoid memory
+// leaking.
+btree *btree_create();
+
+// Creates a new tree from arrays of `length` keys and values, which must be
+// sorted by key in ascending order with no duplicates. The tree is built
+// bottom up in O(n), with the entries spread evenly over as few leaves as
+// they fit in, so every leaf is at least half full. If there is any
+// allocation errors, then NULL is returned. `keys` and `values` must not be
+// NULL unless `length` is 0.
+btree *btree_create_from_sorted(const int *keys, const int *values,
+                                size_t length);
+
+// Creates a new tree from a vector of keys sorted in ascending order and a
+// vector holding the value of each key. If `values` is NULL, every key maps
+// to 0, which is handy for using the tree as a set. Of duplicate keys, the
+// last one wins. See btree_create_from_sorted for everything else. `keys`
+// must not be NULL and `values` must be NULL or as long as `keys`.
+btree *btree_create_from_vector(vector *keys, vector *values);
+
+// Destroys a given tree, freeing the allocated memory. Does nothing if `tree`
+// is NULL.
+void btree_destroy(btree *tree);
+
+// Gets the number of entries in a given tree. `tree` must not be NULL.
+size_t btree_length(btree *tree);
+
+// Maps a given key to a given value in a given tree, replacing any value the
+// key was mapped to before. Returns false if there is any allocation errors,
+// in which case the entry is not added, although nodes on the way may have
+// been split. `tree` must not be NULL.
+bool btree_put(btree *tree, int key, int value);
+
+// Gets the value a given key is mapped to in a given tree. Returns true and
+// puts the value into `value` if the key is in the tree and returns false
+// otherwise. `tree` and `value` must not be NULL.
+bool btree_get(btree *tree, int key, int *value);
+
+// Checks if a given key is in a given tree. `tree` must not be NULL.
+bool btree_contains(btree *tree, int key);
+
+// Removes a given key from a given tree. Returns true and, unless `value` is
+// NULL, puts the value the key was mapped to into `value` if the key was in
+// the tree. Returns false otherwise. Nodes that become less than half full
+// borrow entries from or are merged with a neighbour. `tree` must not be
+// NULL.
+bool btree_remove(btree *tree, int key, int *value);
+
+// Gets the entry with the smallest key in a given tree. Returns false if the
+// tree is empty. `tree`, `key` and `value` must not be NULL.
+bool btree_first(btree *tree, int *key, int *value);
+
+// Gets the entry with the largest key in a given tree. Returns false if the
+// tree is empty. `tree`, `key` and `value` must not be NULL.
+bool btree_last(btree *tree, int *key, int *value);
+
+// Gets an iterator at the entry with the smallest key in a given tree. `tree`
+// must not be NULL.
+btree_iterator btree_begin(btree *tree);
+
+// Gets an iterator at the entry with the smallest key that is greater than or
+// equal to a given key. `tree` must not be NULL.
+btree_iterator btree_lower_bound(btree *tree, int key);
+
+// Gets the entry a given iterator is at and moves it to the next entry.
+// Returns false if the iterator is at the end. `iterator`, `key` and `value`
+// must not be NULL.
+bool btree_iterator_next(btree_iterator *iterator, int *key, int *value);
+
+// Copies the entries whose keys are between `low` and `high`, inclusive, into
+// arrays with room for `capacity` entries, in ascending order of key. Returns
+// the number of entries copied. `tree` must not be NULL and `keys` and
+// `values` must not be NULL unless `capacity` is 0.
+size_t btree_range(btree *tree, int low, int high, int *keys, int *values,
+                   size_t capacity);
+
+void btree_print(btree *tree);
+
+// Makes trees created from now on search their nodes with the kernels of a
+// given CPU level instead of the fastest ones the running CPU supports.
+// Meant for testing the kernels of every level. Returns false and changes
+// nothing if the running CPU does not support `level`.
+bool btree_force_kernels(cpu_level level);
+
+#endif
@@ -0,0 +1,413 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "clist.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Index used in place of a NULL link.
+#define NIL UINT32_MAX
+
+// Maximum number of nodes in a list. One less than NIL, so that no node has
+// the index NIL.
+#define MAX_CAPACITY (NIL - 1)
+
+// Number of nodes a list has room for when it first grows.
+static const uint32_t INITIAL_CAPACITY = 8;
+
+typedef struct node {
+  int value;
+  uint32_t next;
+  uint32_t previous;
+} node;
+
+typedef struct clist {
+  node *nodes;
+  uint32_t capacity;
+  // Number of nodes at the start of `nodes` that have ever been used. Nodes
+  // past this point have never been handed out.
+  uint32_t used;
+  // First node of the free list, which is linked through `next`.
+  uint32_t free;
+  uint32_t head;
+  uint32_t tail;
+  size_t length;
+} clist;
+
+static void link(clist *list, uint32_t previous, uint32_t next) {
+  if (previous != NIL) {
+    list->nodes[previous].next = next;
+  }
+  if (next != NIL) {
+    list->nodes[next].previous = previous;
+  }
+}
+
+// Gets a node that is not in use, growing the node array if necessary.
+// Returns NIL if the list is too large to grow or re-allocation fails.
+static uint32_t node_create(clist *list, int value) {
+  uint32_t i;
+  if (list->free != NIL) {
+    i = list->free;
+    list->free = list->nodes[i].next;
+  } else {
+    if (list->used == list->capacity) {
+      if (list->capacity == MAX_CAPACITY) {
+        return NIL;
+      }
+      uint32_t new_capacity = list->capacity == 0 ? INITIAL_CAPACITY
+                              : list->capacity > MAX_CAPACITY / 2
+                                  ? MAX_CAPACITY
+                                  : list->capacity * 2;
+      size_t size = (size_t)new_capacity * sizeof(node);
+      if (size / sizeof(node) != new_capacity) {
+        // Only possible where size_t is 32 bits
+        return NIL;
+      }
+      node *new_nodes = realloc(list->nodes, size);
+      if (new_nodes == NULL) {
+        return NIL;
+      }
+      list->nodes = new_nodes;
+      list->capacity = new_capacity;
+    }
+    i = list->used++;
+  }
+
+  list->nodes[i].value = value;
+  list->nodes[i].next = NIL;
+  list->nodes[i].previous = NIL;
+  return i;
+}
+
+// Gives a node that is no longer in use back to the free list.
+static void node_destroy(clist *list, uint32_t i) {
+  list->nodes[i].next = list->free;
+  list->free = i;
+}
+
+static uint32_t get_node(clist *list, size_t index) {
+  uint32_t n;
+  if (index <= list->length / 2) {
+    // Index closer to head than tail
+    n = list->head;
+    for (size_t i = 0; i < index; i++) {
+      n = list->nodes[n].next;
+    }
+  } else {
+    // Index closer to tail than head
+    n = list->tail;
+    for (size_t i = list->length - 1; i > index; i--) {
+      n = list->nodes[n].previous;
+    }
+  }
+
+  return n;
+}
+
+clist *clist_create() {
+  clist *list = malloc(sizeof(clist));
+  if (list == NULL) {
+    return NULL;
+  }
+
+  list->nodes = NULL;
+  list->capacity = 0;
+  list->used = 0;
+  list->free = NIL;
+  list->head = NIL;
+  list->tail = NIL;
+  list->length = 0;
+  return list;
+}
+
+clist *clist_create_from_values(int *values, size_t length) {
+  assert(values != NULL &&
+         "Failed to create compact list from values because value array "
+         "pointer was NULL");
+  assert(length <= MAX_CAPACITY &&
+         "Failed to create compact list from values because there were too "
+         "many values");
+
+  clist *list = clist_create();
+  if (list == NULL) {
+    return NULL;
+  }
+  if (length == 0) {
+    return list;
+  }
+
+  // Lay the nodes out in order, so that the list starts out sequential
+  list->nodes = malloc(length * sizeof(node));
+  if (list->nodes == NULL) {
+    free(list);
+    return NULL;
+  }
+  for (size_t i = 0; i < length; i++) {
+    list->nodes[i].value = values[i];
+    list->nodes[i].previous = i == 0 ? NIL : i - 1;
+    list->nodes[i].next = i == length - 1 ? NIL : i + 1;
+  }
+  list->capacity = length;
+  list->used = length;
+  list->head = 0;
+  list->tail = length - 1;
+  list->length = length;
+  return list;
+}
+
+clist *clist_clone(clist *list) {
+  assert(list != NULL &&
+         "Failed to clone compact list because pointer was NULL");
+
+  clist *clone = malloc(sizeof(clist));
+  if (clone == NULL) {
+    return NULL;
+  }
+
+  *clone = *list;
+  clone->capacity = list->used;
+  clone->nodes = NULL;
+  if (list->used > 0) {
+    clone->nodes = malloc(list->used * sizeof(node));
+    if (clone->nodes == NULL) {
+      free(clone);
+      return NULL;
+    }
+    memcpy(clone->nodes, list->nodes, list->used * sizeof(node));
+  }
+  return clone;
+}
+
+void clist_destroy(clist *list) {
+  if (list != NULL) {
+    free(list->nodes);
+    free(list);
+  }
+}
+
+size_t clist_length(clist *list) {
+  assert(list != NULL &&
+         "Failed to get length of compact list because pointer was NULL");
+  return list->length;
+}
+
+bool clist_insert(clist *list, size_t index, int value) {
+  assert(list != NULL &&
+         "Failed to insert value into compact list because pointer was NULL");
+  assert(index <= list->length &&
+         "Failed to insert value into compact list because index was out of "
+         "bounds");
+
+  uint32_t n = node_create(list, value);
+  if (n == NIL) {
+    return false;
+  }
+
+  // Pushing back links after the tail, everything else before a node
+  uint32_t next = index == list->length ? NIL : get_node(list, index);
+  uint32_t previous = next != NIL ? list->nodes[next].previous : list->tail;
+  link(list, previous, n);
+  link(list, n, next);
+  if (previous == NIL) {
+    list->head = n;
+  }
+  if (next == NIL) {
+    list->tail = n;
+  }
+  list->length++;
+  return true;
+}
+
+int clist_remove(clist *list, size_t index) {
+  assert(list != NULL &&
+         "Failed to remove value from compact list because pointer was NULL");
+  assert(index < list->length &&
+         "Failed to remove value from compact list because index was out of "
+         "bounds");
+
+  uint32_t n = get_node(list, index);
+  uint32_t previous = list->nodes[n].previous;
+  uint32_t next = list->nodes[n].next;
+  if (previous == NIL) {
+    list->head = next;
+  }
+  if (next == NIL) {
+    list->tail = previous;
+  }
+  link(list, previous, next);
+  list->length--;
+
+  int value = list->nodes[n].value;
+  node_destroy(list, n);
+  return value;
+}
+
+bool clist_push_back(clist *list, int value) {
+  assert(list != NULL && "Failed to push value onto back of compact list "
+                         "because pointer was NULL");
+  return clist_insert(list, list->length, value);
+}
+
+int clist_back(clist *list) {
+  assert(list != NULL &&
+         "Failed to get back value from compact list because pointer was NULL");
+  return clist_get(list, list->length - 1);
+}
+
+int clist_pop_back(clist *list) {
+  assert(list != NULL && "Failed to pop value from back of compact list "
+                         "because pointer was NULL");
+  return clist_remove(list, list->length - 1);
+}
+
+bool clist_push_front(clist *list, int value) {
+  assert(list != NULL && "Failed to push value onto front of compact list "
+                         "because pointer was NULL");
+  return clist_insert(list, 0, value);
+}
+
+int clist_front(clist *list) {
+  assert(list != NULL && "Failed to get front value from compact list "
+                         "because pointer was NULL");
+  return clist_get(list, 0);
+}
+
+int clist_pop_front(clist *list) {
+  assert(list != NULL && "Failed to pop value from front of compact list "
+                         "because pointer was NULL");
+  return clist_remove(list, 0);
+}
+
+void clist_set(clist *list, size_t index, int value) {
+  assert(list != NULL &&
+         "Failed to set value in compact list because pointer was NULL");
+  assert(index < list->length &&
+         "Failed to set value in compact list because index was out of "
+         "bounds");
+  list->nodes[get_node(list, index)].value = value;
+}
+
+int clist_get(clist *list, size_t index) {
+  assert(list != NULL &&
+         "Failed to get value from compact list because pointer was NULL");
+  assert(index < list->length &&
+         "Failed to get value from compact list because index was out of "
+         "bounds");
+  return list->nodes[get_node(list, index)].value;
+}
+
+void clist_clear(clist *list) {
+  assert(list != NULL &&
+         "Failed to clear compact list because pointer was NULL");
+
+  // Keep the node array around for reuse
+  list->used = 0;
+  list->free = NIL;
+  list->head = NIL;
+  list->tail = NIL;
+  list->length = 0;
+}
+
+bool clist_contains(clist *list, int value) {
+  assert(list != NULL && "Failed to check if compact list contains value "
+                         "because pointer was NULL");
+
+  for (uint32_t ni = list->head; ni != NIL; ni = list->nodes[ni].next) {
+    if (list->nodes[ni].value == value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool clist_equals(clist *list1, clist *list2) {
+  assert((list1 != NULL || list2 != NULL) &&
+         "Failed to compare compact lists because at least one of the "
+         "pointers was NULL");
+
+  if (list1 == list2) {
+    // The pointers refer to the same object
+    return true;
+  }
+
+  if (list1->length != list2->length) {
+    return false;
+  }
+
+  uint32_t n1 = list1->head;
+  uint32_t n2 = list2->head;
+  while (n1 != NIL) {
+    if (list1->nodes[n1].value != list2->nodes[n2].value) {
+      return false;
+    }
+    n1 = list1->nodes[n1].next;
+    n2 = list2->nodes[n2].next;
+  }
+  return true;
+}
+
+bool clist_position(clist *list, int value, size_t *index) {
+  assert(list != NULL &&
+         "Failed to find position of element in compact list because list "
+         "pointer was NULL");
+  assert(index != NULL &&
+         "Failed to return position of element in compact list because index "
+         "pointer was NULL");
+
+  size_t position = 0;
+  for (uint32_t ni = list->head; ni != NIL; ni = list->nodes[ni].next) {
+    if (list->nodes[ni].value == value) {
+      *index = position;
+      return true;
+    }
+    position++;
+  }
+  return false;
+}
+
+bool clist_empty(clist *list) {
+  assert(list != NULL &&
+         "Failed to check if compact list is empty because pointer was NULL");
+  return list->length == 0;
+}
+
+void clist_print(clist *list) {
+  assert(list != NULL &&
+         "Failed to print compact list because pointer was NULL");
+
+  printf("[ ");
+  uint32_t n = list->head;
+  if (n != NIL) {
+    printf("%d", list->nodes[n].value);
+    n = list->nodes[n].next;
+  }
+  while (n != NIL) {
+    printf(" <-> %d", list->nodes[n].value);
+    n = list->nodes[n].next;
+  }
+  printf(" ]\n");
+}
@@ -0,0 +1,60 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CLIST_H
+#define CLIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A compact doubly linked list. It has the same interface as llist, but all
+// nodes live in one contiguous array and link to each other using 32-bit
+// indices, so a node takes 12 bytes instead of 24 plus malloc overhead, the
+// whole list is a single allocation, and cloning is a memcpy. A list can hold
+// at most UINT32_MAX - 1 values.
+typedef struct clist clist;
+
+clist *clist_create();
+clist *clist_create_from_values(int *values, size_t length);
+// Creates a copy of a given list. Returns NULL if there is any allocation
+// errors.
+clist *clist_clone(clist *list);
+void clist_destroy(clist *list);
+size_t clist_length(clist *list);
+bool clist_insert(clist *list, size_t index, int value);
+int clist_remove(clist *list, size_t index);
+bool clist_push_back(clist *list, int value);
+int clist_back(clist *list);
+int clist_pop_back(clist *list);
+bool clist_push_front(clist *list, int value);
+int clist_front(clist *list);
+int clist_pop_front(clist *list);
+void clist_set(clist *list, size_t index, int value);
+int clist_get(clist *list, size_t index);
+void clist_clear(clist *list);
+bool clist_contains(clist *list, int value);
+bool clist_equals(clist *list1, clist *list2);
+bool clist_position(clist *list, int value, size_t *index);
+bool clist_empty(clist *list);
+void clist_print(clist *list);
+
+#endif
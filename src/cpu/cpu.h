@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Runtime detection of the SIMD instruction sets that modules with SIMD
+// kernels pick between. Each module resolves its kernel table from
+// cpu_level_supported() once and caches it using CPU_DEFINE_KERNELS, and
+// offers a way to force a lower level so that tests can check every table on
+// any machine.
+
+// Size of a cache line in bytes on common hardware.
+#define CACHE_LINE 64
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86
+#endif
+
+// Instruction sets in increasing order. Every level includes those below it.
+typedef enum cpu_level {
+  // Portable C only.
+  CPU_LEVEL_SCALAR,
+  CPU_LEVEL_SSE2,
+  // AVX2 together with POPCNT, which every AVX2 CPU has.
+  CPU_LEVEL_AVX2,
+} cpu_level;
+
+static inline cpu_level cpu_probe() {
+#ifdef CPU_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+    return CPU_LEVEL_AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return CPU_LEVEL_SSE2;
+  }
+#endif
+  return CPU_LEVEL_SCALAR;
+}
+
+// Gets the highest level supported by the running CPU. The CPU is only
+// probed the first time this is called.
+static inline cpu_level cpu_level_supported() {
+  static atomic_int cached = -1;
+  int level = atomic_load_explicit(&cached, memory_order_relaxed);
+  if (level < 0) {
+    level = cpu_probe();
+    atomic_store_explicit(&cached, level, memory_order_relaxed);
+  }
+  return (cpu_level)level;
+}
+
+// Defines the kernel table cache of a module whose tables are of type `type`
+// and whose table for a given level is returned by the function `table_for`.
+// This defines two static functions:
+// - `const type *select_kernels()` gets the table in use, picking that of the
+//   highest level the running CPU supports on the first call.
+// - `bool force_kernels(cpu_level level)` makes the table of a given level
+//   the one in use from now on. Returns false and changes nothing if the
+//   running CPU does not support `level`.
+#define CPU_DEFINE_KERNELS(type, table_for)                                    \
+  static _Atomic(const type *) active_kernels = NULL;                          \
+                                                                               \
+  static const type *select_kernels() {                                        \
+    const type *k =                                                            \
+        atomic_load_explicit(&active_kernels, memory_order_relaxed);           \
+    if (k == NULL) {                                                           \
+      k = table_for(cpu_level_supported());                                    \
+      atomic_store_explicit(&active_kernels, k, memory_order_relaxed);         \
+    }                                                                          \
+    return k;                                                                  \
+  }                                                                            \
+                                                                               \
+  static bool force_kernels(cpu_level level) {                                 \
+    if (level > cpu_level_supported()) {                                       \
+      return false;                                                            \
+    }                                                                          \
+    atomic_store_explicit(&active_kernels, table_for(level),                   \
+                          memory_order_relaxed);                               \
+    return true;                                                               \
+  }
+
+#endif
@@ -0,0 +1,293 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "deque.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../vector/vector.h"
+
+typedef struct deque {
+  int *values;
+  // Always a power of two, so that `capacity - 1` masks indices into the ring.
+  size_t capacity;
+  // Position of the front value in `values`.
+  size_t head;
+  size_t length;
+} deque;
+
+// Gets the position in the ring of the value at a given index.
+static size_t slot(deque *dq, size_t index) {
+  return (dq->head + index) & (dq->capacity - 1);
+}
+
+// Rounds a given capacity up to a power of two. Returns 0 if the result would
+// not satisfy vector_capacity_ok.
+static size_t round_capacity(size_t capacity) {
+  size_t rounded = 1;
+  while (rounded < capacity) {
+    if (rounded > SIZE_MAX / 2) {
+      return 0;
+    }
+    rounded *= 2;
+  }
+  return vector_capacity_ok(rounded) ? rounded : 0;
+}
+
+// Gives a given deque a capacity of `capacity`, which must be a larger power
+// of two than its current capacity, and unwraps the values if they wrap
+// around the end of the ring.
+static bool grow(deque *dq, size_t capacity) {
+  int *new_values = realloc(dq->values, capacity * sizeof(int));
+  if (new_values == NULL) {
+    return false;
+  }
+
+  // The new capacity is at least double the old one, so the values that
+  // wrapped around to the start of the ring always fit right after the old end
+  size_t old_capacity = dq->capacity;
+  if (dq->head + dq->length > old_capacity) {
+    size_t wrapped = dq->head + dq->length - old_capacity;
+    memcpy(new_values + old_capacity, new_values, wrapped * sizeof(int));
+  }
+  dq->values = new_values;
+  dq->capacity = capacity;
+  return true;
+}
+
+// Makes sure there is room for `count` more values in a given deque.
+static bool make_room(deque *dq, size_t count) {
+  if (count <= dq->capacity - dq->length) {
+    return true;
+  }
+  if (count > SIZE_MAX - dq->length) {
+    return false;
+  }
+  size_t capacity = round_capacity(dq->length + count);
+  return capacity != 0 && grow(dq, capacity);
+}
+
+deque *deque_create(size_t capacity) {
+  assert(vector_capacity_ok(capacity) &&
+         "Failed to create deque because capacity was either 0 or would cause "
+         "an unsigned integer wrap");
+
+  size_t rounded = round_capacity(capacity);
+  if (rounded == 0) {
+    return NULL;
+  }
+
+  deque *dq = malloc(sizeof(deque));
+  if (dq == NULL) {
+    return NULL;
+  }
+  dq->values = malloc(rounded * sizeof(int));
+  if (dq->values == NULL) {
+    free(dq);
+    return NULL;
+  }
+  dq->capacity = rounded;
+  dq->head = 0;
+  dq->length = 0;
+  return dq;
+}
+
+void deque_destroy(deque *dq) {
+  if (dq != NULL) {
+    free(dq->values);
+    free(dq);
+  }
+}
+
+size_t deque_length(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to get length of deque because pointer was NULL");
+  return dq->length;
+}
+
+size_t deque_capacity(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to get capacity of deque because pointer was NULL");
+  return dq->capacity;
+}
+
+bool deque_empty(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to check if deque is empty because pointer was NULL");
+  return dq->length == 0;
+}
+
+bool deque_reserve(deque *dq, size_t capacity) {
+  assert(dq != NULL &&
+         "Failed to reserve capacity for deque because pointer was NULL");
+
+  if (capacity <= dq->capacity) {
+    return true;
+  }
+  return make_room(dq, capacity - dq->length);
+}
+
+bool deque_push_back(deque *dq, int value) {
+  assert(dq != NULL &&
+         "Failed to push value onto back of deque because pointer was NULL");
+
+  if (dq->length == dq->capacity && !make_room(dq, 1)) {
+    return false;
+  }
+  dq->values[slot(dq, dq->length)] = value;
+  dq->length++;
+  return true;
+}
+
+bool deque_push_front(deque *dq, int value) {
+  assert(dq != NULL &&
+         "Failed to push value onto front of deque because pointer was NULL");
+
+  if (dq->length == dq->capacity && !make_room(dq, 1)) {
+    return false;
+  }
+  dq->head = (dq->head - 1) & (dq->capacity - 1);
+  dq->values[dq->head] = value;
+  dq->length++;
+  return true;
+}
+
+int deque_pop_back(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to pop value off back of deque because pointer was NULL");
+  assert(dq->length > 0 &&
+         "Failed to pop value off back of deque because it was empty");
+
+  dq->length--;
+  return dq->values[slot(dq, dq->length)];
+}
+
+int deque_pop_front(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to pop value off front of deque because pointer was NULL");
+  assert(dq->length > 0 &&
+         "Failed to pop value off front of deque because it was empty");
+
+  int value = dq->values[dq->head];
+  dq->head = (dq->head + 1) & (dq->capacity - 1);
+  dq->length--;
+  return value;
+}
+
+int deque_back(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to get back value of deque because pointer was NULL");
+  assert(dq->length > 0 &&
+         "Failed to get back value of deque because it was empty");
+  return dq->values[slot(dq, dq->length - 1)];
+}
+
+int deque_front(deque *dq) {
+  assert(dq != NULL &&
+         "Failed to get front value of deque because pointer was NULL");
+  assert(dq->length > 0 &&
+         "Failed to get front value of deque because it was empty");
+  return dq->values[dq->head];
+}
+
+int deque_get(deque *dq, size_t index) {
+  assert(dq != NULL && "Failed to get value of deque because pointer was NULL");
+  assert(index < dq->length &&
+         "Failed to get value of deque because index was out of bounds");
+  return dq->values[slot(dq, index)];
+}
+
+void deque_set(deque *dq, size_t index, int value) {
+  assert(dq != NULL && "Failed to set value of deque because pointer was NULL");
+  assert(index < dq->length &&
+         "Failed to set value of deque because index was out of bounds");
+  dq->values[slot(dq, index)] = value;
+}
+
+bool deque_push_back_many(deque *dq, const int *values, size_t count) {
+  assert(dq != NULL &&
+         "Failed to push values onto back of deque because deque pointer was "
+         "NULL");
+  assert((values != NULL || count == 0) &&
+         "Failed to push values onto back of deque because value array "
+         "pointer was NULL");
+
+  if (count == 0) {
+    return true;
+  }
+  if (!make_room(dq, count)) {
+    return false;
+  }
+
+  // Copy up to the end of the ring, then wrap around to its start
+  size_t start = slot(dq, dq->length);
+  size_t first = dq->capacity - start < count ? dq->capacity - start : count;
+  memcpy(dq->values + start, values, first * sizeof(int));
+  memcpy(dq->values, values + first, (count - first) * sizeof(int));
+  dq->length += count;
+  return true;
+}
+
+size_t deque_pop_front_many(deque *dq, int *values, size_t count) {
+  assert(dq != NULL &&
+         "Failed to pop values off front of deque because deque pointer was "
+         "NULL");
+  assert((values != NULL || count == 0) &&
+         "Failed to pop values off front of deque because value array pointer "
+         "was NULL");
+
+  if (count > dq->length) {
+    count = dq->length;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  // Copy up to the end of the ring, then wrap around to its start
+  size_t first =
+      dq->capacity - dq->head < count ? dq->capacity - dq->head : count;
+  memcpy(values, dq->values + dq->head, first * sizeof(int));
+  memcpy(values + first, dq->values, (count - first) * sizeof(int));
+  dq->head = slot(dq, count);
+  dq->length -= count;
+  return count;
+}
+
+void deque_clear(deque *dq) {
+  assert(dq != NULL && "Failed to clear deque because pointer was NULL");
+  dq->head = 0;
+  dq->length = 0;
+}
+
+void deque_print(deque *dq) {
+  assert(dq != NULL && "Failed to print deque because pointer was NULL");
+
+  printf("[ ");
+  for (size_t i = 0; i < dq->length; i++) {
+    printf(i == 0 ? "%d" : ", %d", dq->values[slot(dq, i)]);
+  }
+  printf(" ]\n");
+}
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A double-ended queue backed by a growable ring buffer. Values can be pushed
+// and popped at both ends in amortized O(1) without allocating, so it serves
+// as both a stack and a FIFO queue. The capacity is always a power of two so
+// that positions in the ring are found with a mask instead of a division.
+typedef struct deque deque;
+
+// Creates a new deque with room for at least `capacity` values. The capacity
+// is rounded up to a power of two. Returns NULL if there is any allocation
+// errors or if the rounded capacity is too large. `capacity` must not be 0
+// and must satisfy vector_capacity_ok. When a deque is no longer needed, it
+// should be freed by calling deque_destroy.
+deque *deque_create(size_t capacity);
+
+// Destroys a given deque, freeing the allocated memory. Does nothing if
+// `dq` is NULL.
+void deque_destroy(deque *dq);
+
+// Gets the number of values in a given deque. `dq` must not be NULL.
+size_t deque_length(deque *dq);
+
+// Gets the capacity of a given deque, i.e. how many values it can hold before
+// it has to grow. Always a power of two. `dq` must not be NULL.
+size_t deque_capacity(deque *dq);
+
+// Checks that a given deque holds no values. `dq` must not be NULL.
+bool deque_empty(deque *dq);
+
+// Makes sure that a given deque can hold at least `capacity` values without
+// growing. Returns false if the deque would become too large or an error
+// occurs during re-allocation, in which case the deque is left unchanged.
+// `dq` must not be NULL.
+bool deque_reserve(deque *dq, size_t capacity);
+
+// Pushes a value onto the back of a given deque, doubling its capacity if it
+// is full. Returns false if the deque needs to grow but the growing operation
+// fails. `dq` must not be NULL.
+bool deque_push_back(deque *dq, int value);
+
+// Pushes a value onto the front of a given deque. See deque_push_back for
+// failure conditions.
+bool deque_push_front(deque *dq, int value);
+
+// Pops a value off the back of a given deque. `dq` must not be NULL or empty.
+int deque_pop_back(deque *dq);
+
+// Pops a value off the front of a given deque. `dq` must not be NULL or empty.
+int deque_pop_front(deque *dq);
+
+// Gets the value at the back of a given deque. `dq` must not be NULL or empty.
+int deque_back(deque *dq);
+
+// Gets the value at the front of a given deque. `dq` must not be NULL or
+// empty.
+int deque_front(deque *dq);
+
+// Gets the value at a given index, counting from the front, in a given deque.
+// `dq` must not be NULL and `index` must be within bounds.
+int deque_get(deque *dq, size_t index);
+
+// Sets the value at a given index, counting from the front, in a given deque.
+// `dq` must not be NULL and `index` must be within bounds.
+void deque_set(deque *dq, size_t index, int value);
+
+// Pushes `count` values from a given array onto the back of a given deque,
+// preserving their order. The deque grows at most once and the values are
+// copied in at most two contiguous segments. Returns false if the deque needs
+// to grow but the growing operation fails; the deque is left unchanged in that
+// case. `dq` must not be NULL and `values` must not be NULL unless `count` is
+// 0.
+bool deque_push_back_many(deque *dq, const int *values, size_t count);
+
+// Pops up to `count` values off the front of a given deque into a given
+// array, in order, copying them out in at most two contiguous segments.
+// Returns the number of values popped, which is the smaller of `count` and the
+// length of the deque. `dq` must not be NULL and `values` must not be NULL
+// unless `count` is 0.
+size_t deque_pop_front_many(deque *dq, int *values, size_t count);
+
+// Removes all values from a given deque, keeping its capacity. `dq` must not
+// be NULL.
+void deque_clear(deque *dq);
+
+void deque_print(deque *dq);
+
+#endif
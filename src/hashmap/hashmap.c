@@ -0,0 +1,394 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "hashmap.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Number of control words compared at a time.
+#define GROUP_SIZE 16
+
+// Control word of an empty slot. Control words of full slots are the lowest
+// seven bits of the hash of their key, so they never have the top bit set.
+#define EMPTY 0x80
+
+// Smallest number of slots in a hash map. A group never covers any slot more
+// than once, which keeps the mirrored control words simple.
+#define MIN_SLOTS GROUP_SIZE
+
+typedef struct entry {
+  int key;
+  int value;
+} entry;
+
+typedef struct hashmap {
+  // One control word per slot, followed by copies of the first
+  // GROUP_SIZE - 1, so that a group starting at any slot can be loaded
+  // without wrapping around.
+  uint8_t *control;
+  entry *entries;
+  // Always a power of two.
+  size_t slots;
+  size_t length;
+  // Largest length before the map has to grow.
+  size_t capacity;
+  double max_load_factor;
+} hashmap;
+
+static uint64_t hash(int key) {
+  // Finalizer of MurmurHash3, so that every bit of the key affects both the
+  // slot and the control word
+  uint64_t h = (uint32_t)key;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+static size_t home_slot(hashmap *map, uint64_t h) {
+  return (h >> 7) & (map->slots - 1);
+}
+
+static uint8_t control_word(uint64_t h) { return h & 0x7f; }
+
+// Gets a bit mask of the control words in the group starting at a given slot
+// that are equal to `word`. Bit i is set if the control word of slot
+// `start + i` matches.
+static uint32_t match(hashmap *map, size_t start, uint8_t word) {
+#ifdef __SSE2__
+  __m128i group = _mm_loadu_si128((const __m128i *)(map->control + start));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(word)));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < GROUP_SIZE; i++) {
+    mask |= (uint32_t)(map->control[start + i] == word) << i;
+  }
+  return mask;
+#endif
+}
+
+static void set_control(hashmap *map, size_t slot, uint8_t word) {
+  map->control[slot] = word;
+  if (slot < GROUP_SIZE - 1) {
+    map->control[map->slots + slot] = word;
+  }
+}
+
+// Finds the slot holding a given key. Returns true and puts the slot into
+// `slot` if the key is in the map and returns false otherwise.
+static bool find(hashmap *map, int key, size_t *slot) {
+  uint64_t h = hash(key);
+  uint8_t word = control_word(h);
+  size_t start = home_slot(map, h);
+  while (true) {
+    uint32_t matches = match(map, start, word);
+    while (matches != 0) {
+      size_t i = (start + __builtin_ctz(matches)) & (map->slots - 1);
+      if (map->entries[i].key == key) {
+        *slot = i;
+        return true;
+      }
+      matches &= matches - 1;
+    }
+    // Keys never sit past an empty slot in their probe sequence
+    if (match(map, start, EMPTY) != 0) {
+      return false;
+    }
+    start = (start + GROUP_SIZE) & (map->slots - 1);
+  }
+}
+
+// Puts a key that is not in the map into the first empty slot of its probe
+// sequence. The map must have an empty slot.
+static void insert_new(hashmap *map, int key, int value) {
+  uint64_t h = hash(key);
+  size_t start = home_slot(map, h);
+  uint32_t empty;
+  while ((empty = match(map, start, EMPTY)) == 0) {
+    start = (start + GROUP_SIZE) & (map->slots - 1);
+  }
+  size_t i = (start + __builtin_ctz(empty)) & (map->slots - 1);
+  set_control(map, i, control_word(h));
+  map->entries[i].key = key;
+  map->entries[i].value = value;
+  map->length++;
+}
+
+// Gets the number of slots needed to hold `capacity` entries with a given
+// load factor. Returns 0 if that would be too many.
+static size_t slots_for(size_t capacity, double max_load_factor) {
+  size_t slots = MIN_SLOTS;
+  while ((double)slots * max_load_factor < (double)capacity) {
+    if (slots > SIZE_MAX / 2 / sizeof(entry)) {
+      return 0;
+    }
+    slots *= 2;
+  }
+  return slots;
+}
+
+// Moves the entries of a given map into `slots` new slots, or leaves the map
+// unchanged and returns false if allocation fails.
+static bool rehash(hashmap *map, size_t slots, double max_load_factor) {
+  uint8_t *control = malloc(slots + GROUP_SIZE - 1);
+  entry *entries = malloc(slots * sizeof(entry));
+  if (control == NULL || entries == NULL) {
+    free(control);
+    free(entries);
+    return false;
+  }
+  memset(control, EMPTY, slots + GROUP_SIZE - 1);
+
+  uint8_t *old_control = map->control;
+  entry *old_entries = map->entries;
+  size_t old_slots = map->slots;
+  map->control = control;
+  map->entries = entries;
+  map->slots = slots;
+  map->length = 0;
+  map->capacity = (size_t)((double)slots * max_load_factor);
+  map->max_load_factor = max_load_factor;
+  for (size_t i = 0; i < old_slots; i++) {
+    if (old_control[i] != EMPTY) {
+      insert_new(map, old_entries[i].key, old_entries[i].value);
+    }
+  }
+  free(old_control);
+  free(old_entries);
+  return true;
+}
+
+hashmap *hashmap_create(size_t capacity) {
+  size_t slots = slots_for(capacity, HASHMAP_DEFAULT_MAX_LOAD_FACTOR);
+  if (slots == 0) {
+    return NULL;
+  }
+
+  hashmap *map = malloc(sizeof(hashmap));
+  if (map == NULL) {
+    return NULL;
+  }
+  map->control = NULL;
+  map->entries = NULL;
+  map->slots = 0;
+  if (!rehash(map, slots, HASHMAP_DEFAULT_MAX_LOAD_FACTOR)) {
+    free(map);
+    return NULL;
+  }
+  return map;
+}
+
+void hashmap_destroy(hashmap *map) {
+  if (map != NULL) {
+    free(map->control);
+    free(map->entries);
+    free(map);
+  }
+}
+
+size_t hashmap_length(hashmap *map) {
+  assert(map != NULL &&
+         "Failed to get length of hash map because pointer was NULL");
+  return map->length;
+}
+
+size_t hashmap_capacity(hashmap *map) {
+  assert(map != NULL &&
+         "Failed to get capacity of hash map because pointer was NULL");
+  return map->capacity;
+}
+
+double hashmap_get_max_load_factor(hashmap *map) {
+  assert(map != NULL &&
+         "Failed to get max load factor of hash map because pointer was NULL");
+  return map->max_load_factor;
+}
+
+bool hashmap_set_max_load_factor(hashmap *map, double max_load_factor) {
+  assert(map != NULL &&
+         "Failed to set max load factor of hash map because pointer was NULL");
+  assert(max_load_factor > 0 && max_load_factor < 1 &&
+         "Failed to set max load factor of hash map because it was not "
+         "between 0 and 1");
+
+  size_t slots = slots_for(map->length, max_load_factor);
+  if (slots == 0) {
+    return false;
+  }
+  if (slots <= map->slots) {
+    // Still fits, so only the limit changes
+    map->max_load_factor = max_load_factor;
+    map->capacity = (size_t)((double)map->slots * max_load_factor);
+    return true;
+  }
+  return rehash(map, slots, max_load_factor);
+}
+
+bool hashmap_reserve(hashmap *map, size_t capacity) {
+  assert(map != NULL &&
+         "Failed to reserve capacity for hash map because pointer was NULL");
+
+  if (capacity <= map->capacity) {
+    return true;
+  }
+  size_t slots = slots_for(capacity, map->max_load_factor);
+  return slots != 0 && rehash(map, slots, map->max_load_factor);
+}
+
+bool hashmap_put(hashmap *map, int key, int value) {
+  assert(map != NULL &&
+         "Failed to put entry into hash map because pointer was NULL");
+
+  size_t slot;
+  if (find(map, key, &slot)) {
+    map->entries[slot].value = value;
+    return true;
+  }
+  if (map->length == map->capacity &&
+      (map->length == SIZE_MAX || !hashmap_reserve(map, map->length + 1))) {
+    return false;
+  }
+  insert_new(map, key, value);
+  return true;
+}
+
+bool hashmap_put_many(hashmap *map, const int *keys, const int *values,
+                      size_t count) {
+  assert(map != NULL &&
+         "Failed to put entries into hash map because map pointer was NULL");
+  assert(((keys != NULL && values != NULL) || count == 0) &&
+         "Failed to put entries into hash map because at least one of the "
+         "array pointers was NULL");
+
+  // Assume every key is new, so that the map grows at most once
+  if (count > SIZE_MAX - map->length ||
+      !hashmap_reserve(map, map->length + count)) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    size_t slot;
+    if (find(map, keys[i], &slot)) {
+      map->entries[slot].value = values[i];
+    } else {
+      insert_new(map, keys[i], values[i]);
+    }
+  }
+  return true;
+}
+
+bool hashmap_get(hashmap *map, int key, int *value) {
+  assert(map != NULL && value != NULL &&
+         "Failed to get value from hash map because at least one of the "
+         "pointers was NULL");
+
+  size_t slot;
+  if (!find(map, key, &slot)) {
+    return false;
+  }
+  *value = map->entries[slot].value;
+  return true;
+}
+
+bool hashmap_contains(hashmap *map, int key) {
+  assert(map != NULL &&
+         "Failed to check if hash map contains key because pointer was NULL");
+
+  size_t slot;
+  return find(map, key, &slot);
+}
+
+bool hashmap_remove(hashmap *map, int key, int *value) {
+  assert(map != NULL &&
+         "Failed to remove entry from hash map because pointer was NULL");
+
+  size_t hole;
+  if (!find(map, key, &hole)) {
+    return false;
+  }
+  if (value != NULL) {
+    *value = map->entries[hole].value;
+  }
+
+  // Shift back every following entry of the run that would otherwise be cut
+  // off from its home slot by the hole, moving the hole along
+  size_t mask = map->slots - 1;
+  for (size_t i = (hole + 1) & mask; map->control[i] != EMPTY;
+       i = (i + 1) & mask) {
+    size_t home = home_slot(map, hash(map->entries[i].key));
+    // Distances from home, wrapping around the end of the table
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      set_control(map, hole, map->control[i]);
+      map->entries[hole] = map->entries[i];
+      hole = i;
+    }
+  }
+  set_control(map, hole, EMPTY);
+  map->length--;
+  return true;
+}
+
+bool hashmap_next(hashmap *map, size_t *position, int *key, int *value) {
+  assert(map != NULL && position != NULL && key != NULL && value != NULL &&
+         "Failed to iterate over hash map because at least one of the "
+         "pointers was NULL");
+
+  while (*position < map->slots) {
+    size_t i = (*position)++;
+    if (map->control[i] != EMPTY) {
+      *key = map->entries[i].key;
+      *value = map->entries[i].value;
+      return true;
+    }
+  }
+  return false;
+}
+
+void hashmap_clear(hashmap *map) {
+  assert(map != NULL && "Failed to clear hash map because pointer was NULL");
+  memset(map->control, EMPTY, map->slots + GROUP_SIZE - 1);
+  map->length = 0;
+}
+
+void hashmap_print(hashmap *map) {
+  assert(map != NULL && "Failed to print hash map because pointer was NULL");
+
+  printf("{ ");
+  bool first = true;
+  for (size_t i = 0; i < map->slots; i++) {
+    if (map->control[i] != EMPTY) {
+      printf(first ? "%d: %d" : ", %d: %d", map->entries[i].key,
+             map->entries[i].value);
+      first = false;
+    }
+  }
+  printf(" }\n");
+}
@@ -0,0 +1,118 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A hash map from ints to ints using open addressing in the style of Swiss
+// tables. Next to the entries is an array of one-byte control words holding
+// seven bits of the hash of each key, or a marker for empty slots. Lookups
+// compare 16 control words at a time using SSE2 where available and only
+// look at entries whose control word matches, so that a lookup usually
+// touches one line of control words and one line of entries. Collisions are
+// resolved by linear probing, and removal shifts later entries back instead
+// of leaving tombstones, so that lookups never slow down as entries come and
+// go.
+typedef struct hashmap hashmap;
+
+// Load factor of new hash maps. See hashmap_set_max_load_factor.
+#define HASHMAP_DEFAULT_MAX_LOAD_FACTOR 0.8
+
+// Creates a new hash map with room for at least `capacity` entries before it
+// has to grow. If there is any allocation errors or `capacity` is too large,
+// then NULL is returned. When a hash map created using this function is no
+// longer needed, it should be freed by calling the hashmap_destroy function
+// to avoid memory leaking.
+hashmap *hashmap_create(size_t capacity);
+
+// Destroys a given hash map, freeing the allocated memory. Does nothing if
+// `map` is NULL.
+void hashmap_destroy(hashmap *map);
+
+// Gets the number of entries in a given hash map. `map` must not be NULL.
+size_t hashmap_length(hashmap *map);
+
+// Gets the number of entries a given hash map can hold before it has to grow.
+// `map` must not be NULL.
+size_t hashmap_capacity(hashmap *map);
+
+// Gets the maximum load factor of a given hash map. `map` must not be NULL.
+double hashmap_get_max_load_factor(hashmap *map);
+
+// Sets the maximum load factor of a given hash map, i.e. the fraction of its
+// slots that may be in use before it grows. Lower load factors make lookups
+// faster, especially misses, at the cost of memory. Rehashes the map if it
+// is now over the limit. Returns false if the rehash fails because of an
+// allocation error, in which case the map is left unchanged. `map` must not
+// be NULL and `max_load_factor` must be greater than 0 and less than 1.
+bool hashmap_set_max_load_factor(hashmap *map, double max_load_factor);
+
+// Makes sure that a given hash map can hold at least `capacity` entries
+// without growing. Returns false if `capacity` is too large or an error
+// occurs during re-allocation, in which case the map is left unchanged. `map`
+// must not be NULL.
+bool hashmap_reserve(hashmap *map, size_t capacity);
+
+// Maps a given key to a given value in a given hash map, replacing any value
+// the key was mapped to before. Returns false if the map needs to grow but
+// the growing operation fails. `map` must not be NULL.
+bool hashmap_put(hashmap *map, int key, int value);
+
+// Maps each of `count` keys from a given array to the value at the same index
+// in another array, as if by calling hashmap_put for each. The map grows at
+// most once. Returns false if the map needs to grow but the growing operation
+// fails, in which case the map is left unchanged. `map` must not be NULL and
+// `keys` and `values` must not be NULL unless `count` is 0.
+bool hashmap_put_many(hashmap *map, const int *keys, const int *values,
+                      size_t count);
+
+// Gets the value a given key is mapped to in a given hash map. Returns true
+// and puts the value into `value` if the key is in the map and returns false
+// otherwise. `map` and `value` must not be NULL.
+bool hashmap_get(hashmap *map, int key, int *value);
+
+// Checks if a given key is in a given hash map. `map` must not be NULL.
+bool hashmap_contains(hashmap *map, int key);
+
+// Removes a given key from a given hash map. Returns true and, unless `value`
+// is NULL, puts the value the key was mapped to into `value` if the key was in
+// the map. Returns false otherwise. `map` must not be NULL.
+bool hashmap_remove(hashmap *map, int key, int *value);
+
+// Iterates over the entries of a given hash map in no particular order.
+// `position` must be 0 on the first call and is advanced by each call. Returns
+// true and puts the next entry into `key` and `value` if there is one and
+// returns false once all entries have been visited. The map must not be
+// modified during iteration. `map`, `position`, `key` and `value` must not be
+// NULL.
+bool hashmap_next(hashmap *map, size_t *position, int *key, int *value);
+
+// Removes all entries from a given hash map, keeping its capacity. `map` must
+// not be NULL.
+void hashmap_clear(hashmap *map);
+
+void hashmap_print(hashmap *map);
+
+#endif
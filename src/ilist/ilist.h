@@ -0,0 +1,218 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// An intrusive doubly linked list. Instead of the list allocating nodes that
+// hold copies of values, values embed an ilist_link of their own and the list
+// links those together, so linking and unlinking are O(1) and never allocate.
+// A value can be in as many lists at once as it has links, but each link can
+// only be in one list at a time. The list does not own its values; they must
+// stay alive while linked.
+//
+// struct timer {
+//   int deadline;
+//   ilist_link link;
+// };
+//
+// ilist_push_back(&timers, &timer->link);
+// ILIST_FOR_EACH(l, &timers) {
+//   struct timer *t = ILIST_CONTAINER_OF(l, struct timer, link);
+// }
+
+typedef struct ilist_link {
+  struct ilist_link *next;
+  struct ilist_link *previous;
+} ilist_link;
+
+typedef struct ilist {
+  ilist_link *head;
+  ilist_link *tail;
+  size_t length;
+} ilist;
+
+// Gets a pointer to the value of type `type` that has the link `ptr` as its
+// member `member`.
+#define ILIST_CONTAINER_OF(ptr, type, member)                                  \
+  ((type *)((char *)(ptr) - offsetof(type, member)))
+
+// Iterates `l` over the links of a list from front to back. The current link
+// must not be unlinked during iteration; use ILIST_FOR_EACH_SAFE for that.
+#define ILIST_FOR_EACH(l, list)                                                \
+  for (ilist_link *l = (list)->head; l != NULL; l = l->next)
+
+// Like ILIST_FOR_EACH, but the current link may be unlinked during iteration.
+// `tmp` is used to hold the next link.
+#define ILIST_FOR_EACH_SAFE(l, tmp, list)                                      \
+  for (ilist_link *l = (list)->head, *tmp = l != NULL ? l->next : NULL;        \
+       l != NULL; l = tmp, tmp = l != NULL ? l->next : NULL)
+
+// Links `a` before `b`, where either may be NULL. Works on any node type with
+// `next` and `previous` pointers, so that other lists can share it.
+#define ILIST_LINK(a, b)                                                       \
+  do {                                                                         \
+    if ((a) != NULL) {                                                         \
+      (a)->next = (b);                                                         \
+    }                                                                          \
+    if ((b) != NULL) {                                                         \
+      (b)->previous = (a);                                                     \
+    }                                                                          \
+  } while (0)
+
+// Initializes a list to be empty.
+static inline void ilist_init(ilist *list) {
+  assert(list != NULL &&
+         "Failed to initialize intrusive list because pointer was NULL");
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+}
+
+static inline size_t ilist_length(const ilist *list) {
+  assert(list != NULL &&
+         "Failed to get length of intrusive list because pointer was NULL");
+  return list->length;
+}
+
+static inline bool ilist_empty(const ilist *list) {
+  assert(list != NULL &&
+         "Failed to check if intrusive list is empty because pointer was NULL");
+  return list->length == 0;
+}
+
+// Gets the first link of a list, or NULL if it is empty.
+static inline ilist_link *ilist_front(const ilist *list) {
+  assert(list != NULL &&
+         "Failed to get front of intrusive list because pointer was NULL");
+  return list->head;
+}
+
+// Gets the last link of a list, or NULL if it is empty.
+static inline ilist_link *ilist_back(const ilist *list) {
+  assert(list != NULL &&
+         "Failed to get back of intrusive list because pointer was NULL");
+  return list->tail;
+}
+
+// Links `l` into a list right before `next`, which must be in the list, or at
+// the back if `next` is NULL.
+static inline void ilist_insert_before(ilist *list, ilist_link *next,
+                                       ilist_link *l) {
+  assert(list != NULL && l != NULL &&
+         "Failed to insert link into intrusive list because at least one of "
+         "the pointers was NULL");
+
+  ilist_link *previous = next != NULL ? next->previous : list->tail;
+  ILIST_LINK(previous, l);
+  ILIST_LINK(l, next);
+  if (previous == NULL) {
+    list->head = l;
+  }
+  if (next == NULL) {
+    list->tail = l;
+  }
+  list->length++;
+}
+
+// Links `l` into a list right after `previous`, which must be in the list, or
+// at the front if `previous` is NULL.
+static inline void ilist_insert_after(ilist *list, ilist_link *previous,
+                                      ilist_link *l) {
+  assert(list != NULL &&
+         "Failed to insert link into intrusive list because list pointer was "
+         "NULL");
+  ilist_insert_before(list, previous != NULL ? previous->next : list->head, l);
+}
+
+static inline void ilist_push_back(ilist *list, ilist_link *l) {
+  ilist_insert_before(list, NULL, l);
+}
+
+static inline void ilist_push_front(ilist *list, ilist_link *l) {
+  ilist_insert_after(list, NULL, l);
+}
+
+// Unlinks `l`, which must be in a given list, from it.
+static inline void ilist_remove(ilist *list, ilist_link *l) {
+  assert(list != NULL && l != NULL &&
+         "Failed to remove link from intrusive list because at least one of "
+         "the pointers was NULL");
+  assert(list->length > 0 &&
+         "Failed to remove link from intrusive list because it was empty");
+
+  if (l->previous == NULL) {
+    list->head = l->next;
+  }
+  if (l->next == NULL) {
+    list->tail = l->previous;
+  }
+  ILIST_LINK(l->previous, l->next);
+  l->next = NULL;
+  l->previous = NULL;
+  list->length--;
+}
+
+// Unlinks and returns the first link of a list, or NULL if it is empty.
+static inline ilist_link *ilist_pop_front(ilist *list) {
+  ilist_link *l = ilist_front(list);
+  if (l != NULL) {
+    ilist_remove(list, l);
+  }
+  return l;
+}
+
+// Unlinks and returns the last link of a list, or NULL if it is empty.
+static inline ilist_link *ilist_pop_back(ilist *list) {
+  ilist_link *l = ilist_back(list);
+  if (l != NULL) {
+    ilist_remove(list, l);
+  }
+  return l;
+}
+
+// Moves all links of `src` to the back of `dst` in O(1), leaving `src` empty.
+static inline void ilist_concat(ilist *dst, ilist *src) {
+  assert(dst != NULL && src != NULL &&
+         "Failed to concatenate intrusive lists because at least one of the "
+         "pointers was NULL");
+  assert(dst != src &&
+         "Failed to concatenate intrusive lists because they were the same "
+         "list");
+
+  if (src->head == NULL) {
+    return;
+  }
+  ILIST_LINK(dst->tail, src->head);
+  if (dst->head == NULL) {
+    dst->head = src->head;
+  }
+  dst->tail = src->tail;
+  dst->length += src->length;
+  ilist_init(src);
+}
+
+#endif
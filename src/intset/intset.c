@@ -0,0 +1,1276 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "intset.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector_inline.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// Number of 64-bit words in a bitmap container.
+#define BITMAP_WORDS 1024
+
+// Size of a bitmap container in bytes.
+#define BITMAP_SIZE (BITMAP_WORDS * sizeof(uint64_t))
+
+// Largest number of values in an array container. At this point an array
+// takes as much memory as a bitmap.
+#define ARRAY_MAX 4096
+
+typedef enum container_type {
+  ARRAY,
+  BITMAP,
+  RUN,
+} container_type;
+
+// A run of `length + 1` consecutive values starting at `start`.
+typedef struct run {
+  uint16_t start;
+  uint16_t length;
+} run;
+
+// Largest number of runs a run container has room for. At this point the
+// runs take as much memory as a bitmap.
+#define RUNS_MAX (BITMAP_SIZE / sizeof(run))
+
+// The lower 16 bits of the values of one chunk.
+typedef struct container {
+  container_type type;
+  // Number of values in the container, which is never 0.
+  uint32_t cardinality;
+  // Number of values or runs the array or runs have room for. Unused by
+  // bitmaps.
+  uint32_t capacity;
+  // Number of runs. Unused by arrays and bitmaps.
+  uint32_t runs_length;
+  union {
+    uint16_t *array;
+    uint64_t *bitmap;
+    run *runs;
+  };
+} container;
+
+typedef struct intset {
+  // Upper 16 bits of the values of each chunk, in ascending order.
+  uint16_t *keys;
+  container *containers;
+  // Number of chunks.
+  size_t length;
+  // Number of chunks there is room for.
+  size_t capacity;
+  // Number of values.
+  size_t cardinality;
+} intset;
+
+// Bitmap kernels. Each takes whole bitmap containers and returns the number
+// of bits set in the result.
+typedef struct kernels {
+  uint32_t (*count)(const uint64_t *words);
+  // Replaces `dst` with `dst | src`.
+  uint32_t (*or_count)(uint64_t *dst, const uint64_t *src);
+  // Replaces `dst` with `dst & src`.
+  uint32_t (*and_count)(uint64_t *dst, const uint64_t *src);
+  // Replaces `dst` with `dst & ~src`.
+  uint32_t (*andnot_count)(uint64_t *dst, const uint64_t *src);
+} kernels;
+
+static uint32_t count_scalar(const uint64_t *words) {
+  uint32_t count = 0;
+  for (size_t i = 0; i < BITMAP_WORDS; i++) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+static uint32_t or_count_scalar(uint64_t *dst, const uint64_t *src) {
+  for (size_t i = 0; i < BITMAP_WORDS; i++) {
+    dst[i] |= src[i];
+  }
+  return count_scalar(dst);
+}
+
+static uint32_t and_count_scalar(uint64_t *dst, const uint64_t *src) {
+  for (size_t i = 0; i < BITMAP_WORDS; i++) {
+    dst[i] &= src[i];
+  }
+  return count_scalar(dst);
+}
+
+static uint32_t andnot_count_scalar(uint64_t *dst, const uint64_t *src) {
+  for (size_t i = 0; i < BITMAP_WORDS; i++) {
+    dst[i] &= ~src[i];
+  }
+  return count_scalar(dst);
+}
+
+static const kernels SCALAR_KERNELS = {
+    .count = count_scalar,
+    .or_count = or_count_scalar,
+    .and_count = and_count_scalar,
+    .andnot_count = andnot_count_scalar,
+};
+
+#ifdef CPU_X86
+
+// Counts the bits set in each 64-bit lane of a vector by looking up the count
+// of every nibble in a table, as described by Mula, Kurz and Lemire.
+__attribute__((target("avx2"))) static __m256i popcount_avx2(__m256i v) {
+  const __m256i table =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1,
+                       2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i low = _mm256_and_si256(v, low_mask);
+  __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, low),
+                                   _mm256_shuffle_epi8(table, high));
+  return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2"))) static uint32_t
+sum_lanes_avx2(__m256i counts) {
+  uint64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, counts);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2"))) static uint32_t
+count_avx2(const uint64_t *words) {
+  __m256i counts = _mm256_setzero_si256();
+  for (size_t i = 0; i < BITMAP_WORDS; i += 4) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(words + i));
+    counts = _mm256_add_epi64(counts, popcount_avx2(v));
+  }
+  return sum_lanes_avx2(counts);
+}
+
+// Defines a kernel that combines bitmaps with a given AVX2 operation and
+// counts the bits of the result in the same pass.
+#define DEFINE_OP_AVX2(name, op)                                               \
+  __attribute__((target("avx2"))) static uint32_t name##_avx2(                 \
+      uint64_t *dst, const uint64_t *src) {                                    \
+    __m256i counts = _mm256_setzero_si256();                                   \
+    for (size_t i = 0; i < BITMAP_WORDS; i += 4) {                             \
+      __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));              \
+      __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));              \
+      __m256i result = op;                                                     \
+      _mm256_storeu_si256((__m256i *)(dst + i), result);                       \
+      counts = _mm256_add_epi64(counts, popcount_avx2(result));                \
+    }                                                                          \
+    return sum_lanes_avx2(counts);                                             \
+  }
+
+DEFINE_OP_AVX2(or_count, _mm256_or_si256(a, b))
+DEFINE_OP_AVX2(and_count, _mm256_and_si256(a, b))
+DEFINE_OP_AVX2(andnot_count, _mm256_andnot_si256(b, a))
+
+static const kernels AVX2_KERNELS = {
+    .count = count_avx2,
+    .or_count = or_count_avx2,
+    .and_count = and_count_avx2,
+    .andnot_count = andnot_count_avx2,
+};
+
+#endif
+
+// Gets the fastest set of kernels available at a given CPU level.
+static const kernels *kernels_for(cpu_level level) {
+#ifdef CPU_X86
+  if (level >= CPU_LEVEL_AVX2) {
+    return &AVX2_KERNELS;
+  }
+#endif
+  (void)level;
+  return &SCALAR_KERNELS;
+}
+
+CPU_DEFINE_KERNELS(kernels, kernels_for)
+
+// Maps ints to unsigned ints in the same order, so that the negative values
+// come first.
+static uint32_t to_unsigned(int value) { return (uint32_t)value ^ 0x80000000; }
+
+static int from_unsigned(uint32_t value) {
+  return (int)(value ^ 0x80000000);
+}
+
+// Finds the first index in a sorted array of `length` values whose value is
+// not less than `value`.
+static size_t lower_bound(const uint16_t *values, size_t length,
+                          uint16_t value) {
+  size_t low = 0;
+  size_t high = length;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (values[middle] < value) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+// Finds the number of runs of a given container that start at or before a
+// given value, so that the run that may hold the value is the one before.
+static size_t runs_before(const container *c, uint16_t value) {
+  size_t low = 0;
+  size_t high = c->runs_length;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (c->runs[middle].start <= value) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+static uint32_t run_end(const run *r) { return (uint32_t)r->start + r->length; }
+
+// Sets the bits from `start` to `end`, inclusive, of a bitmap.
+static void bitmap_set_range(uint64_t *words, uint32_t start, uint32_t end) {
+  size_t first = start / 64;
+  size_t last = end / 64;
+  uint64_t first_mask = ~(uint64_t)0 << (start % 64);
+  uint64_t last_mask = ~(uint64_t)0 >> (63 - end % 64);
+  if (first == last) {
+    words[first] |= first_mask & last_mask;
+    return;
+  }
+  words[first] |= first_mask;
+  for (size_t i = first + 1; i < last; i++) {
+    words[i] = ~(uint64_t)0;
+  }
+  words[last] |= last_mask;
+}
+
+static bool container_contains(const container *c, uint16_t value) {
+  switch (c->type) {
+  case ARRAY: {
+    size_t i = lower_bound(c->array, c->cardinality, value);
+    return i < c->cardinality && c->array[i] == value;
+  }
+  case BITMAP:
+    return (c->bitmap[value / 64] >> (value % 64)) & 1;
+  case RUN: {
+    size_t i = runs_before(c, value);
+    return i > 0 && value <= run_end(&c->runs[i - 1]);
+  }
+  }
+  return false;
+}
+
+static void container_destroy(container *c) {
+  // All pointers of the union are at the same address
+  free(c->array);
+}
+
+// Writes all values of a given container into a bitmap.
+static void container_to_bitmap(const container *c, uint64_t *words) {
+  switch (c->type) {
+  case ARRAY:
+    memset(words, 0, BITMAP_SIZE);
+    for (uint32_t i = 0; i < c->cardinality; i++) {
+      words[c->array[i] / 64] |= (uint64_t)1 << (c->array[i] % 64);
+    }
+    break;
+  case BITMAP:
+    memcpy(words, c->bitmap, BITMAP_SIZE);
+    break;
+  case RUN:
+    memset(words, 0, BITMAP_SIZE);
+    for (uint32_t i = 0; i < c->runs_length; i++) {
+      bitmap_set_range(words, c->runs[i].start, run_end(&c->runs[i]));
+    }
+    break;
+  }
+}
+
+// Writes up to `limit` values of a given container into an array in
+// ascending order. Returns the number of values written.
+static size_t container_to_array(const container *c, uint16_t *values,
+                                 size_t limit) {
+  size_t count = 0;
+  switch (c->type) {
+  case ARRAY:
+    count = c->cardinality < limit ? c->cardinality : limit;
+    memcpy(values, c->array, count * sizeof(uint16_t));
+    break;
+  case BITMAP:
+    for (size_t i = 0; i < BITMAP_WORDS && count < limit; i++) {
+      for (uint64_t word = c->bitmap[i]; word != 0 && count < limit;
+           word &= word - 1) {
+        values[count++] = i * 64 + __builtin_ctzll(word);
+      }
+    }
+    break;
+  case RUN:
+    for (uint32_t i = 0; i < c->runs_length && count < limit; i++) {
+      for (uint32_t v = c->runs[i].start;
+           v <= run_end(&c->runs[i]) && count < limit; v++) {
+        values[count++] = v;
+      }
+    }
+    break;
+  }
+  return count;
+}
+
+// Writes up to `limit` values of a given container, whose chunk has a given
+// key, into an array of ints in ascending order. Returns the number of values
+// written.
+static size_t container_to_ints(const container *c, uint16_t key, int *values,
+                                size_t limit) {
+  uint32_t high = (uint32_t)key << 16;
+  size_t count = 0;
+  switch (c->type) {
+  case ARRAY:
+    for (uint32_t i = 0; i < c->cardinality && count < limit; i++) {
+      values[count++] = from_unsigned(high | c->array[i]);
+    }
+    break;
+  case BITMAP:
+    for (size_t i = 0; i < BITMAP_WORDS && count < limit; i++) {
+      for (uint64_t word = c->bitmap[i]; word != 0 && count < limit;
+           word &= word - 1) {
+        values[count++] =
+            from_unsigned(high | (i * 64 + __builtin_ctzll(word)));
+      }
+    }
+    break;
+  case RUN:
+    for (uint32_t i = 0; i < c->runs_length && count < limit; i++) {
+      for (uint32_t v = c->runs[i].start;
+           v <= run_end(&c->runs[i]) && count < limit; v++) {
+        values[count++] = from_unsigned(high | v);
+      }
+    }
+    break;
+  }
+  return count;
+}
+
+// Turns a given bitmap, holding `cardinality` values, into a container,
+// using an array if the values fit in one. Takes ownership of the bitmap.
+// Returns false if allocation fails, in which case the bitmap is freed.
+static bool container_from_bitmap(container *c, uint64_t *words,
+                                  uint32_t cardinality) {
+  c->cardinality = cardinality;
+  c->capacity = 0;
+  c->runs_length = 0;
+  if (cardinality > ARRAY_MAX) {
+    c->type = BITMAP;
+    c->bitmap = words;
+    return true;
+  }
+
+  c->type = ARRAY;
+  c->capacity = cardinality;
+  c->array = malloc((cardinality > 0 ? cardinality : 1) * sizeof(uint16_t));
+  if (c->array == NULL) {
+    free(words);
+    return false;
+  }
+  container bitmap = {.type = BITMAP, .bitmap = words};
+  container_to_array(&bitmap, c->array, cardinality);
+  free(words);
+  return true;
+}
+
+// Converts a given container to a bitmap in place.
+static bool convert_to_bitmap(container *c) {
+  uint64_t *words = malloc(BITMAP_SIZE);
+  if (words == NULL) {
+    return false;
+  }
+  container_to_bitmap(c, words);
+  container_destroy(c);
+  c->type = BITMAP;
+  c->bitmap = words;
+  c->capacity = 0;
+  c->runs_length = 0;
+  return true;
+}
+
+// Converts a given container to an array in place. The container must hold
+// at most ARRAY_MAX values.
+static bool convert_to_array(container *c) {
+  uint16_t *values = malloc(c->cardinality * sizeof(uint16_t));
+  if (values == NULL) {
+    return false;
+  }
+  container_to_array(c, values, c->cardinality);
+  container_destroy(c);
+  c->type = ARRAY;
+  c->array = values;
+  c->capacity = c->cardinality;
+  c->runs_length = 0;
+  return true;
+}
+
+// Counts the runs of consecutive values in a given container.
+static uint32_t count_runs(const container *c) {
+  uint32_t runs = 0;
+  switch (c->type) {
+  case ARRAY:
+    for (uint32_t i = 0; i < c->cardinality; i++) {
+      runs += i == 0 || c->array[i] != c->array[i - 1] + 1;
+    }
+    break;
+  case BITMAP: {
+    // A run starts at every set bit whose lower neighbour is not set
+    uint64_t carry = 0;
+    for (size_t i = 0; i < BITMAP_WORDS; i++) {
+      uint64_t word = c->bitmap[i];
+      runs += __builtin_popcountll(word & ~((word << 1) | carry));
+      carry = word >> 63;
+    }
+    break;
+  }
+  case RUN:
+    runs = c->runs_length;
+    break;
+  }
+  return runs;
+}
+
+static size_t container_size(container_type type, uint32_t capacity) {
+  switch (type) {
+  case ARRAY:
+    return capacity * sizeof(uint16_t);
+  case BITMAP:
+    return BITMAP_SIZE;
+  case RUN:
+    return capacity * sizeof(run);
+  }
+  return 0;
+}
+
+// Converts a given container to runs in place.
+static bool convert_to_runs(container *c, uint32_t runs_length) {
+  run *runs = malloc(runs_length * sizeof(run));
+  if (runs == NULL) {
+    return false;
+  }
+
+  uint32_t length = 0;
+  uint32_t previous = 0;
+  for (uint32_t v = 0; v < 65536; v++) {
+    // Walk the values through the cheapest membership test available
+    if (!container_contains(c, v)) {
+      continue;
+    }
+    if (length > 0 && v == previous + 1) {
+      runs[length - 1].length++;
+    } else {
+      runs[length++] = (run){v, 0};
+    }
+    previous = v;
+  }
+  container_destroy(c);
+  c->type = RUN;
+  c->runs = runs;
+  c->capacity = runs_length;
+  c->runs_length = runs_length;
+  return true;
+}
+
+// Checks if `runs_length` runs take more memory than an array or a bitmap
+// holding the same `cardinality` values.
+static bool runs_too_large(uint32_t runs_length, uint32_t cardinality) {
+  size_t size = container_size(ARRAY, cardinality);
+  if (size > BITMAP_SIZE) {
+    size = BITMAP_SIZE;
+  }
+  return container_size(RUN, runs_length) > size;
+}
+
+// Converts a given run container in place to whichever of an array or a
+// bitmap takes less memory.
+static bool convert_from_runs(container *c) {
+  return c->cardinality <= ARRAY_MAX ? convert_to_array(c)
+                                     : convert_to_bitmap(c);
+}
+
+// Makes sure a given array or run container has room for one more value or
+// run.
+static bool reserve_one(container *c, size_t element_size) {
+  uint32_t used = c->type == RUN ? c->runs_length : c->cardinality;
+  if (used < c->capacity) {
+    return true;
+  }
+  uint32_t capacity = c->capacity > 0 ? c->capacity * 2 : 4;
+  if (c->type == ARRAY && capacity > ARRAY_MAX) {
+    capacity = ARRAY_MAX;
+  }
+  if (c->type == RUN && capacity > RUNS_MAX) {
+    capacity = RUNS_MAX;
+  }
+  void *grown = realloc(c->array, capacity * element_size);
+  if (grown == NULL) {
+    return false;
+  }
+  c->array = grown;
+  c->capacity = capacity;
+  return true;
+}
+
+// Adds a value to a given container. Returns false if allocation fails.
+// Otherwise, `added` tells if the value was new.
+static bool container_add(container *c, uint16_t value, bool *added) {
+  *added = false;
+  switch (c->type) {
+  case ARRAY: {
+    size_t i = lower_bound(c->array, c->cardinality, value);
+    if (i < c->cardinality && c->array[i] == value) {
+      return true;
+    }
+    if (c->cardinality == ARRAY_MAX) {
+      if (!convert_to_bitmap(c)) {
+        return false;
+      }
+      return container_add(c, value, added);
+    }
+    if (!reserve_one(c, sizeof(uint16_t))) {
+      return false;
+    }
+    memmove(c->array + i + 1, c->array + i,
+            (c->cardinality - i) * sizeof(uint16_t));
+    c->array[i] = value;
+    break;
+  }
+  case BITMAP: {
+    uint64_t bit = (uint64_t)1 << (value % 64);
+    if (c->bitmap[value / 64] & bit) {
+      return true;
+    }
+    c->bitmap[value / 64] |= bit;
+    break;
+  }
+  case RUN: {
+    size_t i = runs_before(c, value);
+    if (i > 0 && value <= run_end(&c->runs[i - 1])) {
+      return true;
+    }
+    bool extends_previous = i > 0 && run_end(&c->runs[i - 1]) + 1 == value;
+    bool extends_next =
+        i < c->runs_length && c->runs[i].start == (uint32_t)value + 1;
+    if (extends_previous && extends_next) {
+      // Bridges two runs
+      c->runs[i - 1].length += c->runs[i].length + 2;
+      memmove(c->runs + i, c->runs + i + 1,
+              (c->runs_length - i - 1) * sizeof(run));
+      c->runs_length--;
+    } else if (extends_previous) {
+      c->runs[i - 1].length++;
+    } else if (extends_next) {
+      c->runs[i].start--;
+      c->runs[i].length++;
+    } else {
+      if (runs_too_large(c->runs_length + 1, c->cardinality + 1)) {
+        // Another run would not pay off, so the value goes into an array or
+        // a bitmap instead
+        if (!convert_from_runs(c)) {
+          return false;
+        }
+        return container_add(c, value, added);
+      }
+      if (!reserve_one(c, sizeof(run))) {
+        return false;
+      }
+      memmove(c->runs + i + 1, c->runs + i,
+              (c->runs_length - i) * sizeof(run));
+      c->runs[i] = (run){value, 0};
+      c->runs_length++;
+    }
+    break;
+  }
+  }
+  c->cardinality++;
+  *added = true;
+  return true;
+}
+
+// Removes a value from a given container. Returns false if allocation fails.
+// Otherwise, `removed` tells if the value was there.
+static bool container_remove(container *c, uint16_t value, bool *removed) {
+  *removed = false;
+  switch (c->type) {
+  case ARRAY: {
+    size_t i = lower_bound(c->array, c->cardinality, value);
+    if (i == c->cardinality || c->array[i] != value) {
+      return true;
+    }
+    memmove(c->array + i, c->array + i + 1,
+            (c->cardinality - i - 1) * sizeof(uint16_t));
+    break;
+  }
+  case BITMAP: {
+    uint64_t bit = (uint64_t)1 << (value % 64);
+    if (!(c->bitmap[value / 64] & bit)) {
+      return true;
+    }
+    c->bitmap[value / 64] &= ~bit;
+    break;
+  }
+  case RUN: {
+    size_t i = runs_before(c, value);
+    if (i == 0 || value > run_end(&c->runs[i - 1])) {
+      return true;
+    }
+    run *r = &c->runs[i - 1];
+    if (r->length == 0) {
+      memmove(c->runs + i - 1, c->runs + i,
+              (c->runs_length - i) * sizeof(run));
+      c->runs_length--;
+    } else if (value == r->start) {
+      r->start++;
+      r->length--;
+    } else if (value == run_end(r)) {
+      r->length--;
+    } else {
+      // Splits the run in two, unless another run would not pay off
+      if (runs_too_large(c->runs_length + 1, c->cardinality - 1)) {
+        if (!convert_from_runs(c)) {
+          return false;
+        }
+        return container_remove(c, value, removed);
+      }
+      if (!reserve_one(c, sizeof(run))) {
+        return false;
+      }
+      r = &c->runs[i - 1];
+      memmove(c->runs + i + 1, c->runs + i,
+              (c->runs_length - i) * sizeof(run));
+      c->runs[i] = (run){value + 1, run_end(r) - value - 1};
+      r->length = value - r->start - 1;
+      c->runs_length++;
+    }
+    break;
+  }
+  }
+  c->cardinality--;
+  *removed = true;
+
+  // Bitmaps only go back to arrays well below ARRAY_MAX, so that adding and
+  // removing around the limit does not convert back and forth. Failing to
+  // convert just leaves a valid bitmap.
+  if (c->type == BITMAP && c->cardinality <= ARRAY_MAX / 2 &&
+      c->cardinality > 0) {
+    convert_to_array(c);
+  }
+  // Likewise, runs are converted once they take more memory than the values
+  // would in an array or a bitmap. Failing to convert just leaves valid runs.
+  if (c->type == RUN && c->cardinality > 0 &&
+      runs_too_large(c->runs_length, c->cardinality)) {
+    convert_from_runs(c);
+  }
+  return true;
+}
+
+static bool container_clone(const container *c, container *clone) {
+  *clone = *c;
+  size_t size = c->type == BITMAP ? BITMAP_SIZE
+                                  : container_size(c->type, c->capacity);
+  clone->array = malloc(size > 0 ? size : 1);
+  if (clone->array == NULL) {
+    return false;
+  }
+  memcpy(clone->array, c->array, size);
+  return true;
+}
+
+// Merges the values of two array containers into a new array container.
+// The result must fit in an array.
+static bool array_union(const container *c1, const container *c2,
+                        container *result) {
+  uint16_t *values = malloc((c1->cardinality + c2->cardinality) *
+                            sizeof(uint16_t));
+  if (values == NULL) {
+    return false;
+  }
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t length = 0;
+  while (i < c1->cardinality && j < c2->cardinality) {
+    uint16_t a = c1->array[i];
+    uint16_t b = c2->array[j];
+    values[length++] = a <= b ? a : b;
+    i += a <= b;
+    j += b <= a;
+  }
+  while (i < c1->cardinality) {
+    values[length++] = c1->array[i++];
+  }
+  while (j < c2->cardinality) {
+    values[length++] = c2->array[j++];
+  }
+  *result = (container){.type = ARRAY,
+                        .cardinality = length,
+                        .capacity = c1->cardinality + c2->cardinality,
+                        .array = values};
+  return true;
+}
+
+// Keeps the values of array container `c1` that are, or with `keep` false
+// are not, in `c2`. The result may be empty.
+static bool array_filter(const container *c1, const container *c2, bool keep,
+                         container *result) {
+  uint16_t *values = malloc(c1->cardinality * sizeof(uint16_t));
+  if (values == NULL) {
+    return false;
+  }
+  uint32_t length = 0;
+  if (c2->type == ARRAY && keep) {
+    // Both sorted, so intersect by merging, without branching on the values
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i < c1->cardinality && j < c2->cardinality) {
+      uint16_t a = c1->array[i];
+      uint16_t b = c2->array[j];
+      values[length] = a;
+      length += a == b;
+      i += a <= b;
+      j += b <= a;
+    }
+  } else {
+    for (uint32_t i = 0; i < c1->cardinality; i++) {
+      if (container_contains(c2, c1->array[i]) == keep) {
+        values[length++] = c1->array[i];
+      }
+    }
+  }
+  *result = (container){.type = ARRAY,
+                        .cardinality = length,
+                        .capacity = c1->cardinality,
+                        .array = values};
+  return true;
+}
+
+typedef enum operation {
+  UNION,
+  INTERSECTION,
+  DIFFERENCE,
+} operation;
+
+// Combines two containers of the same chunk into a new container. The result
+// may be empty, in which case it must still be destroyed.
+static bool container_combine(const kernels *k, const container *c1,
+                              const container *c2, operation op,
+                              container *result) {
+  // Arrays are cheaper to combine value by value than through bitmaps
+  if (op == UNION && c1->type == ARRAY && c2->type == ARRAY &&
+      c1->cardinality + c2->cardinality <= ARRAY_MAX) {
+    return array_union(c1, c2, result);
+  }
+  if (op == INTERSECTION && c2->type == ARRAY && c1->type != ARRAY) {
+    return array_filter(c2, c1, true, result);
+  }
+  if ((op == INTERSECTION || op == DIFFERENCE) && c1->type == ARRAY) {
+    return array_filter(c1, c2, op == INTERSECTION, result);
+  }
+
+  uint64_t *words = malloc(BITMAP_SIZE);
+  if (words == NULL) {
+    return false;
+  }
+  container_to_bitmap(c1, words);
+
+  uint32_t cardinality;
+  if (c2->type == ARRAY) {
+    // Only unions and differences of non-arrays get here
+    for (uint32_t i = 0; i < c2->cardinality; i++) {
+      uint64_t bit = (uint64_t)1 << (c2->array[i] % 64);
+      if (op == UNION) {
+        words[c2->array[i] / 64] |= bit;
+      } else {
+        words[c2->array[i] / 64] &= ~bit;
+      }
+    }
+    cardinality = k->count(words);
+  } else {
+    uint64_t *other = c2->bitmap;
+    uint64_t *materialized = NULL;
+    if (c2->type == RUN) {
+      materialized = malloc(BITMAP_SIZE);
+      if (materialized == NULL) {
+        free(words);
+        return false;
+      }
+      container_to_bitmap(c2, materialized);
+      other = materialized;
+    }
+    cardinality = op == UNION          ? k->or_count(words, other)
+                  : op == INTERSECTION ? k->and_count(words, other)
+                                       : k->andnot_count(words, other);
+    free(materialized);
+  }
+  return container_from_bitmap(result, words, cardinality);
+}
+
+// Makes sure a given set has room for one more chunk.
+static bool reserve_chunk(intset *set) {
+  if (set->length < set->capacity) {
+    return true;
+  }
+  size_t capacity = set->capacity > 0 ? set->capacity * 2 : 4;
+  uint16_t *keys = realloc(set->keys, capacity * sizeof(uint16_t));
+  if (keys == NULL) {
+    return false;
+  }
+  set->keys = keys;
+  container *containers =
+      realloc(set->containers, capacity * sizeof(container));
+  if (containers == NULL) {
+    return false;
+  }
+  set->containers = containers;
+  set->capacity = capacity;
+  return true;
+}
+
+// Appends a chunk to a given set, whose chunks must all have smaller keys.
+// Takes ownership of the container, destroying it if it is empty or if
+// allocation fails.
+static bool append_chunk(intset *set, uint16_t key, container *c) {
+  if (c->cardinality == 0) {
+    container_destroy(c);
+    return true;
+  }
+  if (!reserve_chunk(set)) {
+    container_destroy(c);
+    return false;
+  }
+  set->keys[set->length] = key;
+  set->containers[set->length] = *c;
+  set->length++;
+  set->cardinality += c->cardinality;
+  return true;
+}
+
+static void remove_chunk(intset *set, size_t i) {
+  container_destroy(&set->containers[i]);
+  memmove(set->keys + i, set->keys + i + 1,
+          (set->length - i - 1) * sizeof(uint16_t));
+  memmove(set->containers + i, set->containers + i + 1,
+          (set->length - i - 1) * sizeof(container));
+  set->length--;
+}
+
+intset *intset_create() {
+  intset *set = malloc(sizeof(intset));
+  if (set == NULL) {
+    return NULL;
+  }
+  set->keys = NULL;
+  set->containers = NULL;
+  set->length = 0;
+  set->capacity = 0;
+  set->cardinality = 0;
+  return set;
+}
+
+// Creates the smallest container for `length` sorted, distinct values that
+// all belong to the same chunk.
+static bool container_from_sorted(const uint32_t *values, size_t length,
+                                  container *c) {
+  uint32_t runs_length = 0;
+  for (size_t i = 0; i < length; i++) {
+    runs_length += i == 0 || values[i] != values[i - 1] + 1;
+  }
+
+  size_t array_size = container_size(ARRAY, length);
+  size_t runs_size = container_size(RUN, runs_length);
+  *c = (container){.cardinality = length};
+  if (runs_size < array_size && runs_size < BITMAP_SIZE) {
+    c->type = RUN;
+    c->runs = malloc(runs_size);
+    if (c->runs == NULL) {
+      return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+      uint16_t low = values[i] & 0xffff;
+      if (i > 0 && values[i] == values[i - 1] + 1) {
+        c->runs[c->runs_length - 1].length++;
+      } else {
+        c->runs[c->runs_length++] = (run){low, 0};
+      }
+    }
+    c->capacity = runs_length;
+  } else if (length <= ARRAY_MAX) {
+    c->type = ARRAY;
+    c->array = malloc(array_size);
+    if (c->array == NULL) {
+      return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+      c->array[i] = values[i] & 0xffff;
+    }
+    c->capacity = length;
+  } else {
+    c->type = BITMAP;
+    c->bitmap = calloc(BITMAP_WORDS, sizeof(uint64_t));
+    if (c->bitmap == NULL) {
+      return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+      uint16_t low = values[i] & 0xffff;
+      c->bitmap[low / 64] |= (uint64_t)1 << (low % 64);
+    }
+  }
+  return true;
+}
+
+intset *intset_create_from_vector(vector *vec) {
+  assert(vec != NULL &&
+         "Failed to create int set from vector because pointer was NULL");
+
+  intset *set = intset_create();
+  if (set == NULL) {
+    return NULL;
+  }
+  if (vector_length(vec) == 0) {
+    return set;
+  }
+
+  vector *sorted = vector_create(vector_length(vec));
+  if (sorted == NULL || !vector_extend_from(sorted, vec) ||
+      !vector_sort(sorted)) {
+    vector_destroy(sorted);
+    intset_destroy(set);
+    return NULL;
+  }
+
+  // Drop duplicates, mapping to unsigned values along the way. Sorting ints
+  // sorts their unsigned counterparts too.
+  uint32_t *values = (uint32_t *)vector_data(sorted);
+  size_t length = 0;
+  for (size_t i = 0; i < vector_length(sorted); i++) {
+    uint32_t value = to_unsigned(vector_data(sorted)[i]);
+    if (length == 0 || value != values[length - 1]) {
+      values[length++] = value;
+    }
+  }
+
+  size_t start = 0;
+  while (start < length) {
+    uint16_t key = values[start] >> 16;
+    size_t end = start;
+    while (end < length && values[end] >> 16 == key) {
+      end++;
+    }
+    container c;
+    if (!container_from_sorted(values + start, end - start, &c) ||
+        !append_chunk(set, key, &c)) {
+      vector_destroy(sorted);
+      intset_destroy(set);
+      return NULL;
+    }
+    start = end;
+  }
+
+  vector_destroy(sorted);
+  return set;
+}
+
+intset *intset_clone(intset *set) {
+  assert(set != NULL && "Failed to clone int set because pointer was NULL");
+
+  intset *clone = intset_create();
+  if (clone == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < set->length; i++) {
+    container c;
+    if (!container_clone(&set->containers[i], &c) ||
+        !append_chunk(clone, set->keys[i], &c)) {
+      intset_destroy(clone);
+      return NULL;
+    }
+  }
+  return clone;
+}
+
+void intset_destroy(intset *set) {
+  if (set != NULL) {
+    for (size_t i = 0; i < set->length; i++) {
+      container_destroy(&set->containers[i]);
+    }
+    free(set->keys);
+    free(set->containers);
+    free(set);
+  }
+}
+
+size_t intset_length(intset *set) {
+  assert(set != NULL &&
+         "Failed to get length of int set because pointer was NULL");
+  return set->cardinality;
+}
+
+bool intset_add(intset *set, int value) {
+  assert(set != NULL &&
+         "Failed to add value to int set because pointer was NULL");
+
+  uint32_t u = to_unsigned(value);
+  uint16_t key = u >> 16;
+  size_t i = lower_bound(set->keys, set->length, key);
+  if (i == set->length || set->keys[i] != key) {
+    // New chunk
+    if (!reserve_chunk(set)) {
+      return false;
+    }
+    uint16_t *array = malloc(sizeof(uint16_t));
+    if (array == NULL) {
+      return false;
+    }
+    array[0] = u & 0xffff;
+    memmove(set->keys + i + 1, set->keys + i,
+            (set->length - i) * sizeof(uint16_t));
+    memmove(set->containers + i + 1, set->containers + i,
+            (set->length - i) * sizeof(container));
+    set->keys[i] = key;
+    set->containers[i] = (container){
+        .type = ARRAY, .cardinality = 1, .capacity = 1, .array = array};
+    set->length++;
+    set->cardinality++;
+    return true;
+  }
+
+  bool added;
+  if (!container_add(&set->containers[i], u & 0xffff, &added)) {
+    return false;
+  }
+  set->cardinality += added;
+  return true;
+}
+
+bool intset_remove(intset *set, int value) {
+  assert(set != NULL &&
+         "Failed to remove value from int set because pointer was NULL");
+
+  uint32_t u = to_unsigned(value);
+  uint16_t key = u >> 16;
+  size_t i = lower_bound(set->keys, set->length, key);
+  if (i == set->length || set->keys[i] != key) {
+    return true;
+  }
+
+  bool removed;
+  if (!container_remove(&set->containers[i], u & 0xffff, &removed)) {
+    return false;
+  }
+  set->cardinality -= removed;
+  if (set->containers[i].cardinality == 0) {
+    remove_chunk(set, i);
+  }
+  return true;
+}
+
+bool intset_contains(intset *set, int value) {
+  assert(set != NULL &&
+         "Failed to check if int set contains value because pointer was NULL");
+
+  uint32_t u = to_unsigned(value);
+  uint16_t key = u >> 16;
+  size_t i = lower_bound(set->keys, set->length, key);
+  return i < set->length && set->keys[i] == key &&
+         container_contains(&set->containers[i], u & 0xffff);
+}
+
+// Combines two sets chunk by chunk into a new set.
+static intset *combine(intset *set1, intset *set2, operation op) {
+  const kernels *k = select_kernels();
+  intset *result = intset_create();
+  if (result == NULL) {
+    return NULL;
+  }
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < set1->length || j < set2->length) {
+    bool in1 = i < set1->length &&
+               (j == set2->length || set1->keys[i] <= set2->keys[j]);
+    bool in2 = j < set2->length &&
+               (i == set1->length || set2->keys[j] <= set1->keys[i]);
+    uint16_t key = in1 ? set1->keys[i] : set2->keys[j];
+
+    container c;
+    bool ok = true;
+    bool keep = false;
+    if (in1 && in2) {
+      ok = container_combine(k, &set1->containers[i], &set2->containers[j], op,
+                             &c);
+      keep = true;
+    } else if (in1 && op != INTERSECTION) {
+      ok = container_clone(&set1->containers[i], &c);
+      keep = true;
+    } else if (in2 && op == UNION) {
+      ok = container_clone(&set2->containers[j], &c);
+      keep = true;
+    }
+    if (!ok || (keep && !append_chunk(result, key, &c))) {
+      intset_destroy(result);
+      return NULL;
+    }
+    i += in1;
+    j += in2;
+  }
+  return result;
+}
+
+intset *intset_union(intset *set1, intset *set2) {
+  assert(set1 != NULL && set2 != NULL &&
+         "Failed to create union of int sets because at least one of the "
+         "pointers was NULL");
+  return combine(set1, set2, UNION);
+}
+
+intset *intset_intersection(intset *set1, intset *set2) {
+  assert(set1 != NULL && set2 != NULL &&
+         "Failed to create intersection of int sets because at least one of "
+         "the pointers was NULL");
+  return combine(set1, set2, INTERSECTION);
+}
+
+intset *intset_difference(intset *set1, intset *set2) {
+  assert(set1 != NULL && set2 != NULL &&
+         "Failed to create difference of int sets because at least one of "
+         "the pointers was NULL");
+  return combine(set1, set2, DIFFERENCE);
+}
+
+bool intset_equals(intset *set1, intset *set2) {
+  assert(set1 != NULL && set2 != NULL &&
+         "Failed to compare int sets because at least one of the pointers "
+         "was NULL");
+
+  if (set1->cardinality != set2->cardinality ||
+      set1->length != set2->length) {
+    return false;
+  }
+  // The keys of empty sets may be NULL
+  if (set1->length > 0 &&
+      memcmp(set1->keys, set2->keys, set1->length * sizeof(uint16_t)) != 0) {
+    return false;
+  }
+  for (size_t i = 0; i < set1->length; i++) {
+    const container *c1 = &set1->containers[i];
+    const container *c2 = &set2->containers[i];
+    if (c1->cardinality != c2->cardinality) {
+      return false;
+    }
+    // Same number of values, so checking one way is enough
+    if (c1->type == ARRAY) {
+      for (uint32_t v = 0; v < c1->cardinality; v++) {
+        if (!container_contains(c2, c1->array[v])) {
+          return false;
+        }
+      }
+    } else {
+      for (uint32_t v = 0; v < 65536; v++) {
+        if (container_contains(c1, v) && !container_contains(c2, v)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool intset_optimize(intset *set) {
+  assert(set != NULL && "Failed to optimize int set because pointer was NULL");
+
+  for (size_t i = 0; i < set->length; i++) {
+    container *c = &set->containers[i];
+    if (c->type == RUN) {
+      continue;
+    }
+    uint32_t runs_length = count_runs(c);
+    size_t size = c->type == BITMAP
+                      ? BITMAP_SIZE
+                      : container_size(ARRAY, c->cardinality);
+    if (container_size(RUN, runs_length) < size &&
+        !convert_to_runs(c, runs_length)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t intset_to_array(intset *set, int *values, size_t capacity) {
+  assert(set != NULL &&
+         "Failed to copy int set to array because set pointer was NULL");
+  assert((values != NULL || capacity == 0) &&
+         "Failed to copy int set to array because value array pointer was "
+         "NULL");
+
+  size_t count = 0;
+  for (size_t i = 0; i < set->length && count < capacity; i++) {
+    count += container_to_ints(&set->containers[i], set->keys[i],
+                               values + count, capacity - count);
+  }
+  return count;
+}
+
+size_t intset_memory_usage(intset *set) {
+  assert(set != NULL &&
+         "Failed to get memory usage of int set because pointer was NULL");
+
+  size_t size = sizeof(intset) +
+                set->capacity * (sizeof(uint16_t) + sizeof(container));
+  for (size_t i = 0; i < set->length; i++) {
+    size += container_size(set->containers[i].type,
+                           set->containers[i].capacity);
+  }
+  return size;
+}
+
+void intset_print(intset *set) {
+  assert(set != NULL && "Failed to print int set because pointer was NULL");
+
+  printf("{ ");
+  bool first = true;
+  for (size_t i = 0; i < set->length; i++) {
+    const container *c = &set->containers[i];
+    uint32_t high = (uint32_t)set->keys[i] << 16;
+    for (uint32_t v = 0; v < 65536; v++) {
+      if (container_contains(c, v)) {
+        printf(first ? "%d" : ", %d", from_unsigned(high | v));
+        first = false;
+      }
+    }
+  }
+  printf(" }\n");
+}
+
+bool intset_force_kernels(cpu_level level) { return force_kernels(level); }
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INTSET_H
+#define INTSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector.h"
+
+// A compressed set of ints in the style of Roaring bitmaps. The values are
+// split into chunks of 2^16 by their upper 16 bits, and each chunk is stored
+// in whichever container suits it: a sorted array of the lower 16 bits for
+// sparse chunks, a 2^16-bit bitmap for dense chunks, or a sorted array of
+// runs of consecutive values. This keeps large sets small, and set algebra
+// works chunk by chunk, combining bitmaps a whole word or, with AVX2, 256
+// bits at a time.
+typedef struct intset intset;
+
+// Creates a new, empty set. If there is any allocation errors, then NULL is
+// returned. When a set created using this function is no longer needed, it
+// should be freed by calling the intset_destroy function to avoid memory
+// leaking.
+intset *intset_create();
+
+// Creates a new set holding the distinct values of a given vector, which is
+// not modified and need not be sorted. Every chunk gets the smallest of the
+// three containers. If there is any allocation errors, then NULL is
+// returned. `vec` must not be NULL.
+intset *intset_create_from_vector(vector *vec);
+
+// Creates a copy of a given set. If there is any allocation errors, then NULL
+// is returned. `set` must not be NULL.
+intset *intset_clone(intset *set);
+
+// Destroys a given set, freeing the allocated memory. Does nothing if `set`
+// is NULL.
+void intset_destroy(intset *set);
+
+// Gets the number of values in a given set. `set` must not be NULL.
+size_t intset_length(intset *set);
+
+// Adds a given value to a given set if it is not already there. Returns false
+// if there is any allocation errors, in which case the set is left unchanged.
+// `set` must not be NULL.
+bool intset_add(intset *set, int value);
+
+// Removes a given value from a given set if it is there. Removing a value from
+// the middle of a run of values needs room for another run, so this returns
+// false if there is any allocation errors, in which case the set is left
+// unchanged. `set` must not be NULL.
+bool intset_remove(intset *set, int value);
+
+// Checks if a given set contains a given value. `set` must not be NULL.
+bool intset_contains(intset *set, int value);
+
+// Creates a new set holding the values that are in either of two given sets.
+// If there is any allocation errors, then NULL is returned. `set1` and `set2`
+// must not be NULL.
+intset *intset_union(intset *set1, intset *set2);
+
+// Creates a new set holding the values that are in both of two given sets.
+// See intset_union for failure conditions.
+intset *intset_intersection(intset *set1, intset *set2);
+
+// Creates a new set holding the values of `set1` that are not in `set2`. See
+// intset_union for failure conditions.
+intset *intset_difference(intset *set1, intset *set2);
+
+// Checks if two given sets hold the same values. `set1` and `set2` must not
+// be NULL.
+bool intset_equals(intset *set1, intset *set2);
+
+// Converts every container of a given set that would be smaller as runs of
+// consecutive values into runs. Worth calling after adding many consecutive
+// values one at a time, since containers only become runs when created from
+// a vector or by this function. Runs that edits later make larger than an
+// array or a bitmap are converted back on their own. Returns false if there
+// is any allocation errors, in which case the containers converted so far
+// stay converted. `set` must not be NULL.
+bool intset_optimize(intset *set);
+
+// Copies the values of a given set in ascending order into an array with room
+// for `capacity` values. Returns the number of values copied, which is the
+// smaller of the length of the set and `capacity`. `set` must not be NULL
+// and `values` must not be NULL unless `capacity` is 0.
+size_t intset_to_array(intset *set, int *values, size_t capacity);
+
+// Gets the number of bytes of memory used by a given set, not counting
+// allocator overhead. `set` must not be NULL.
+size_t intset_memory_usage(intset *set);
+
+void intset_print(intset *set);
+
+// Makes bitmap operations use the kernels of a given CPU level from now on
+// instead of the fastest ones the running CPU supports. Meant for testing
+// the kernels of every level. Returns false and changes nothing if the
+// running CPU does not support `level`.
+bool intset_force_kernels(cpu_level level);
+
+#endif
@@ -23,32 +23,125 @@
 #include "llist.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-typedef struct node {
+#include "../allocator/allocator.h"
+#include "../ilist/ilist.h"
+
+typedef struct llist_node {
   int value;
-  struct node *next;
-  struct node *previous;
+  struct llist_node *next;
+  struct llist_node *previous;
 } node;
 
+// A chunk of nodes allocated in one go by a pool.
+typedef struct slab {
+  struct slab *next;
+  node nodes[];
+} slab;
+
+typedef struct llist_pool {
+  // All slabs of the pool, newest first. Nodes are handed out from the newest
+  // slab, and only when it is used up is a new one allocated.
+  slab *slabs;
+  // Number of nodes in slabs allocated when the newest one is used up.
+  size_t nodes_per_slab;
+  // Number of nodes in the newest slab, which may differ from
+  // `nodes_per_slab` if it was sized up front for a known number of nodes.
+  size_t newest_size;
+  // Number of nodes handed out from the newest slab.
+  size_t used;
+  // Nodes that have been given back to the pool, linked through their `next`
+  // pointers.
+  node *free_nodes;
+} llist_pool;
+
 typedef struct llist {
   node *head;
   node *tail;
   size_t length;
+  // Pool that nodes are allocated from, or NULL to use `allocator`.
+  llist_pool *pool;
+  // Whether `pool` belongs to this list alone.
+  bool owns_pool;
+  // The node most recently looked up or inserted and its index, or NULL if
+  // there is none. Lookups near it walk from it instead of the head or tail.
+  node *finger;
+  size_t finger_index;
+  llist_stats stats;
+  // Where the nodes are allocated from if the list has no pool.
+  allocator allocator;
+  // Where the list itself is allocated from.
+  allocator list_allocator;
 } llist;
 
+// Number of nodes per slab of pools created by llist_create_pooled.
+static const size_t DEFAULT_NODES_PER_SLAB = 256;
+
 static void link(node *previous, node *next) {
-  if (previous != NULL) {
-    previous->next = next;
+  ILIST_LINK(previous, next);
+}
+
+// Adds a new, empty slab of `size` nodes to a given pool, which nodes are
+// then handed out from. Returns false if allocation fails.
+static bool pool_add_slab(llist_pool *pool, size_t size) {
+  slab *s = malloc(sizeof(slab) + size * sizeof(node));
+  if (s == NULL) {
+    return false;
+  }
+  s->next = pool->slabs;
+  pool->slabs = s;
+  pool->newest_size = size;
+  pool->used = 0;
+  return true;
+}
+
+static node *pool_alloc(llist_pool *pool) {
+  if (pool->free_nodes != NULL) {
+    node *n = pool->free_nodes;
+    pool->free_nodes = n->next;
+    return n;
+  }
+
+  if (pool->slabs == NULL || pool->used == pool->newest_size) {
+    if (!pool_add_slab(pool, pool->nodes_per_slab)) {
+      return NULL;
+    }
   }
-  if (next != NULL) {
-    next->previous = previous;
+  return &pool->slabs->nodes[pool->used++];
+}
+
+// Gives the chain of nodes from `first` to `last`, linked through their
+// `next` pointers, back to a given pool in one go.
+static void pool_free_chain(llist_pool *pool, node *first, node *last) {
+  last->next = pool->free_nodes;
+  pool->free_nodes = first;
+}
+
+// Frees every slab of a given pool except the newest one, which is kept empty
+// for reuse. Any nodes handed out by the pool become invalid.
+static void pool_reset(llist_pool *pool) {
+  if (pool->slabs != NULL) {
+    slab *s = pool->slabs->next;
+    while (s != NULL) {
+      slab *tmp = s;
+      s = s->next;
+      free(tmp);
+    }
+    pool->slabs->next = NULL;
   }
+  pool->used = 0;
+  pool->free_nodes = NULL;
 }
 
-node *node_create(int value) {
-  node *n = malloc(sizeof(node));
+// Creates a node for a given list, taking it from the pool of the list if it
+// has one and from its allocator otherwise.
+static node *node_create(llist *list, int value) {
+  node *n = list->pool != NULL
+                ? pool_alloc(list->pool)
+                : allocator_allocate(&list->allocator, sizeof(node));
   if (n == NULL) {
     return NULL;
   }
@@ -59,9 +152,98 @@ node *node_create(int value) {
   return n;
 }
 
+// Links a node into a given list right before `next`, or at the back if
+// `next` is NULL. `index` is the index of the node once it is linked. The
+// node becomes the finger.
+static void link_before(llist *list, node *next, node *n, size_t index) {
+  node *previous = next != NULL ? next->previous : list->tail;
+  link(previous, n);
+  link(n, next);
+  if (previous == NULL) {
+    list->head = n;
+  }
+  if (next == NULL) {
+    list->tail = n;
+  }
+  list->length++;
+  list->finger = n;
+  list->finger_index = index;
+}
+
+// Unlinks a node at a given index from a given list without destroying it.
+// If the node is the finger, the finger moves to a neighbour.
+static void unlink_node(llist *list, node *n, size_t index) {
+  if (n == list->finger) {
+    if (n->next != NULL) {
+      list->finger = n->next;
+    } else {
+      list->finger = n->previous;
+      list->finger_index--;
+    }
+  } else if (list->finger != NULL && index < list->finger_index) {
+    list->finger_index--;
+  }
+
+  if (n->previous == NULL) {
+    list->head = n->next;
+  }
+  if (n->next == NULL) {
+    list->tail = n->previous;
+  }
+  link(n->previous, n->next);
+  list->length--;
+}
+
+// Destroys a node of a given list, giving it back to the pool of the list if
+// it has one.
+static void node_destroy(llist *list, node *n) {
+  if (list->pool != NULL) {
+    pool_free_chain(list->pool, n, n);
+  } else {
+    allocator_deallocate(&list->allocator, n, sizeof(node));
+  }
+}
+
+// Destroys the chain of nodes from `first` to `last`, linked through their
+// `next` pointers, in one go if the list has a pool.
+static void chain_destroy(llist *list, node *first, node *last) {
+  if (list->pool != NULL) {
+    pool_free_chain(list->pool, first, last);
+    return;
+  }
+  last->next = NULL;
+  while (first != NULL) {
+    node *tmp = first;
+    first = first->next;
+    allocator_deallocate(&list->allocator, tmp, sizeof(node));
+  }
+}
+
+// Gets the node at a given index, walking from whichever of the head, the
+// tail and the finger is closest. The node becomes the finger.
 static node *get_node(llist *list, size_t index) {
+  list->stats.lookups++;
+
+  size_t from_head = index;
+  size_t from_tail = list->length - 1 - index;
+  size_t from_finger = SIZE_MAX;
+  if (list->finger != NULL) {
+    from_finger = index >= list->finger_index ? index - list->finger_index
+                                              : list->finger_index - index;
+  }
+
   node *n;
-  if (index <= list->length / 2) {
+  if (from_finger <= from_head && from_finger <= from_tail) {
+    // Index closest to finger
+    list->stats.finger_hits++;
+    n = list->finger;
+    for (size_t i = list->finger_index; i < index; i++) {
+      n = n->next;
+    }
+    for (size_t i = list->finger_index; i > index; i--) {
+      n = n->previous;
+    }
+  } else if (from_head <= from_tail) {
     // Index closer to head than tail
     n = list->head;
     for (size_t i = 0; i < index; i++) {
@@ -75,11 +257,30 @@ static node *get_node(llist *list, size_t index) {
     }
   }
 
+  list->finger = n;
+  list->finger_index = index;
   return n;
 }
 
 llist *llist_create() {
-  llist *list = malloc(sizeof(llist));
+  allocator allocator = allocator_default();
+  return llist_create_with_allocator(&allocator);
+}
+
+llist *llist_create_with_allocator(const allocator *allocator) {
+  assert(allocator_ok(allocator) &&
+         "Failed to create linked list with allocator because allocator was "
+         "NULL or invalid");
+  return llist_create_with_allocators(allocator, allocator);
+}
+
+llist *llist_create_with_allocators(const allocator *list_allocator,
+                                    const allocator *node_allocator) {
+  assert(allocator_ok(list_allocator) && allocator_ok(node_allocator) &&
+         "Failed to create linked list with allocators because at least one "
+         "of the allocators was NULL or invalid");
+
+  llist *list = allocator_allocate(list_allocator, sizeof(llist));
   if (list == NULL) {
     return NULL;
   }
@@ -87,26 +288,131 @@ llist *llist_create() {
   list->head = NULL;
   list->tail = NULL;
   list->length = 0;
+  list->pool = NULL;
+  list->owns_pool = false;
+  list->allocator = *node_allocator;
+  list->list_allocator = *list_allocator;
+  list->finger = NULL;
+  list->finger_index = 0;
+  list->stats.lookups = 0;
+  list->stats.finger_hits = 0;
+  return list;
+}
+
+llist *llist_create_pooled() {
+  llist_pool *pool = llist_pool_create(DEFAULT_NODES_PER_SLAB);
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  llist *list = llist_create_with_pool(pool);
+  if (list == NULL) {
+    llist_pool_destroy(pool);
+    return NULL;
+  }
+  list->owns_pool = true;
   return list;
 }
 
+llist *llist_create_with_pool(llist_pool *pool) {
+  assert(pool != NULL &&
+         "Failed to create linked list with pool because pool pointer was "
+         "NULL");
+
+  llist *list = llist_create();
+  if (list == NULL) {
+    return NULL;
+  }
+  list->pool = pool;
+  return list;
+}
+
+llist_pool *llist_pool_create(size_t nodes_per_slab) {
+  assert(nodes_per_slab > 0 &&
+         "Failed to create linked list pool because slab size was 0");
+  assert(nodes_per_slab <= (SIZE_MAX - sizeof(slab)) / sizeof(node) &&
+         "Failed to create linked list pool because slab size would cause an "
+         "unsigned integer wrap");
+
+  llist_pool *pool = malloc(sizeof(llist_pool));
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  pool->slabs = NULL;
+  pool->nodes_per_slab = nodes_per_slab;
+  pool->newest_size = 0;
+  pool->used = 0;
+  pool->free_nodes = NULL;
+  return pool;
+}
+
+void llist_pool_destroy(llist_pool *pool) {
+  if (pool != NULL) {
+    pool_reset(pool);
+    free(pool->slabs);
+    free(pool);
+  }
+}
+
 llist *llist_create_from_values(int *values, size_t length) {
   assert(values != NULL &&
          "Failed to create linked list from values because value array pointer "
          "was NULL");
 
   llist *list = llist_create();
-  for (int i = 0; i < length; i++) {
-    int value = *(values + i);
-    llist_push_back(list, value);
+  if (list == NULL) {
+    return NULL;
+  }
+  if (!llist_extend_from_array(list, values, length)) {
+    llist_destroy(list);
+    return NULL;
+  }
+  return list;
+}
+
+llist *llist_create_pooled_from_values(int *values, size_t length) {
+  assert(values != NULL &&
+         "Failed to create pooled linked list from values because value array "
+         "pointer was NULL");
+
+  // Only the first slab is sized to fit the values, so that pushing one more
+  // value later does not allocate another slab just as large
+  llist_pool *pool = llist_pool_create(DEFAULT_NODES_PER_SLAB);
+  if (pool == NULL) {
+    return NULL;
+  }
+  if (length > 0 &&
+      (length > (SIZE_MAX - sizeof(slab)) / sizeof(node) ||
+       !pool_add_slab(pool, length))) {
+    llist_pool_destroy(pool);
+    return NULL;
+  }
+
+  llist *list = llist_create_with_pool(pool);
+  if (list == NULL) {
+    llist_pool_destroy(pool);
+    return NULL;
+  }
+  list->owns_pool = true;
+
+  if (!llist_extend_from_array(list, values, length)) {
+    llist_destroy(list);
+    return NULL;
   }
   return list;
 }
 
 void llist_destroy(llist *list) {
   if (list != NULL) {
-    llist_clear(list);
-    free(list);
+    if (list->owns_pool) {
+      llist_pool_destroy(list->pool);
+    } else {
+      llist_clear(list);
+    }
+    // Copied out first, since it lives in the list being freed
+    allocator list_allocator = list->list_allocator;
+    allocator_deallocate(&list_allocator, list, sizeof(llist));
   }
 }
 
@@ -123,30 +429,14 @@ bool llist_insert(llist *list, size_t index, int value) {
          "Failed to insert value into linked list because index was out of "
          "bounds");
 
-  node *n = node_create(value);
+  node *n = node_create(list, value);
   if (n == NULL) {
     return false;
   }
 
-  if (list->head == NULL) {
-    // No elements in list
-    list->head = n;
-    list->tail = n;
-  } else if (index == 0) {
-    // Push front
-    link(n, list->head);
-    list->head = n;
-  } else if (index == list->length) {
-    // Push back
-    link(list->tail, n);
-    list->tail = n;
-  } else {
-    // Insert in the middle
-    node *ni = get_node(list, index);
-    link(ni->previous, n);
-    link(n, ni);
-  }
-  list->length++;
+  // Pushing back links after the tail, everything else before a node
+  node *next = index == list->length ? NULL : get_node(list, index);
+  link_before(list, next, n, index);
   return true;
 }
 
@@ -158,17 +448,9 @@ int llist_remove(llist *list, size_t index) {
          "bounds");
 
   node *n = get_node(list, index);
-  if (index == 0) {
-    list->head = n->next;
-  } else if (index == list->length - 1) {
-    link(n->previous, NULL);
-    list->tail = n->previous;
-  } else {
-    link(n->previous, n->next);
-  }
-  list->length--;
+  unlink_node(list, n, index);
   int value = n->value;
-  free(n);
+  node_destroy(list, n);
   return value;
 }
 
@@ -237,16 +519,16 @@ void llist_clear(llist *list) {
   assert(list != NULL &&
          "Failed to get value from linked list because pointer was NULL");
 
-  node *n = list->head;
-  node *tmp;
-  while (n != NULL) {
-    tmp = n;
-    n = n->next;
-    free(tmp);
+  if (list->owns_pool) {
+    // Nobody else has nodes in the pool, so all slabs can go at once
+    pool_reset(list->pool);
+  } else if (list->head != NULL) {
+    chain_destroy(list, list->head, list->tail);
   }
   list->head = NULL;
   list->tail = NULL;
   list->length = 0;
+  list->finger = NULL;
 }
 
 bool llist_contains(llist *list, int value) {
@@ -313,6 +595,388 @@ bool llist_empty(llist *list) {
   return list->length == 0;
 }
 
+bool llist_extend_from_array(llist *list, int *values, size_t length) {
+  assert(list != NULL &&
+         "Failed to extend linked list from array because list pointer was "
+         "NULL");
+  assert((values != NULL || length == 0) &&
+         "Failed to extend linked list from array because value array pointer "
+         "was NULL");
+
+  if (length == 0) {
+    return true;
+  }
+
+  // Build the new nodes as a chain of their own first, so that nothing has to
+  // be undone in the list if an allocation fails halfway
+  node *first = node_create(list, values[0]);
+  if (first == NULL) {
+    return false;
+  }
+  node *last = first;
+  for (size_t i = 1; i < length; i++) {
+    node *n = node_create(list, values[i]);
+    if (n == NULL) {
+      chain_destroy(list, first, last);
+      return false;
+    }
+    n->previous = last;
+    last->next = n;
+    last = n;
+  }
+
+  link(list->tail, first);
+  if (list->head == NULL) {
+    list->head = first;
+  }
+  list->tail = last;
+  list->length += length;
+  return true;
+}
+
+size_t llist_to_array(llist *list, int *values, size_t capacity) {
+  assert(list != NULL &&
+         "Failed to copy linked list to array because list pointer was NULL");
+  assert((values != NULL || capacity == 0) &&
+         "Failed to copy linked list to array because value array pointer was "
+         "NULL");
+
+  size_t count = 0;
+  for (node *n = list->head; n != NULL && count < capacity; n = n->next) {
+    values[count++] = n->value;
+  }
+  return count;
+}
+
+// Checks that nodes can be moved between two given lists, i.e. that both
+// allocate nodes in the same way. Lists that own their pool can only move
+// nodes within themselves, since their nodes die with them.
+static bool nodes_movable(llist *list1, llist *list2) {
+  return list1->pool == list2->pool &&
+         (list1->pool != NULL ||
+          allocator_equal(&list1->allocator, &list2->allocator));
+}
+
+// Moves the chain of `count` nodes from `first` to `last` out of `src` and
+// into `dst` right before `next`, or at the back if `next` is NULL. Both
+// lists lose their fingers.
+static void move_chain(llist *dst, node *next, llist *src, node *first,
+                       node *last, size_t count) {
+  // Cut the chain out of the source
+  if (first->previous == NULL) {
+    src->head = last->next;
+  }
+  if (last->next == NULL) {
+    src->tail = first->previous;
+  }
+  link(first->previous, last->next);
+  src->length -= count;
+  src->finger = NULL;
+
+  // Paste it into the destination
+  node *previous = next != NULL ? next->previous : dst->tail;
+  link(previous, first);
+  link(last, next);
+  if (previous == NULL) {
+    dst->head = first;
+  }
+  if (next == NULL) {
+    dst->tail = last;
+  }
+  dst->length += count;
+  dst->finger = NULL;
+}
+
+void llist_concat(llist *dst, llist *src) {
+  assert(dst != NULL && src != NULL &&
+         "Failed to concatenate linked lists because at least one of the "
+         "pointers was NULL");
+  assert(dst != src &&
+         "Failed to concatenate linked lists because they were the same list");
+  assert(nodes_movable(dst, src) &&
+         "Failed to concatenate linked lists because they allocate nodes "
+         "differently");
+
+  if (src->head != NULL) {
+    move_chain(dst, NULL, src, src->head, src->tail, src->length);
+  }
+}
+
+void llist_splice(llist *dst, size_t index, llist *src, size_t src_index,
+                  size_t count) {
+  assert(dst != NULL && src != NULL &&
+         "Failed to splice linked lists because at least one of the pointers "
+         "was NULL");
+  assert(dst != src &&
+         "Failed to splice linked lists because they were the same list");
+  assert(nodes_movable(dst, src) &&
+         "Failed to splice linked lists because they allocate nodes "
+         "differently");
+  assert(index <= dst->length &&
+         "Failed to splice linked lists because index was out of bounds");
+  assert(src_index <= src->length && count <= src->length - src_index &&
+         "Failed to splice linked lists because source range was out of "
+         "bounds");
+
+  if (count == 0) {
+    return;
+  }
+  node *next = index == dst->length ? NULL : get_node(dst, index);
+  node *first = get_node(src, src_index);
+  node *last = get_node(src, src_index + count - 1);
+  move_chain(dst, next, src, first, last, count);
+}
+
+llist *llist_split_at(llist *list, size_t index) {
+  assert(list != NULL &&
+         "Failed to split linked list because pointer was NULL");
+  assert(index <= list->length &&
+         "Failed to split linked list because index was out of bounds");
+  assert(!list->owns_pool &&
+         "Failed to split linked list because it owns its pool");
+
+  llist *rest =
+      llist_create_with_allocators(&list->list_allocator, &list->allocator);
+  if (rest == NULL) {
+    return NULL;
+  }
+  rest->pool = list->pool;
+
+  if (index < list->length) {
+    node *first = get_node(list, index);
+    move_chain(rest, NULL, list, first, list->tail, list->length - index);
+  }
+  return rest;
+}
+
+void llist_reverse(llist *list) {
+  assert(list != NULL &&
+         "Failed to reverse linked list because pointer was NULL");
+
+  node *n = list->head;
+  while (n != NULL) {
+    node *next = n->next;
+    n->next = n->previous;
+    n->previous = next;
+    n = next;
+  }
+  node *head = list->head;
+  list->head = list->tail;
+  list->tail = head;
+  if (list->finger != NULL) {
+    list->finger_index = list->length - 1 - list->finger_index;
+  }
+}
+
+// Merges two sorted chains of nodes linked through their `next` pointers only
+// and returns the head of the merged chain. Ties are taken from `chain1`
+// first, so merging is stable if `chain1` holds the earlier values.
+static node *merge_chains(node *chain1, node *chain2) {
+  node merged;
+  node *tail = &merged;
+  while (chain1 != NULL && chain2 != NULL) {
+    if (chain2->value < chain1->value) {
+      tail->next = chain2;
+      chain2 = chain2->next;
+    } else {
+      tail->next = chain1;
+      chain1 = chain1->next;
+    }
+    tail = tail->next;
+  }
+  tail->next = chain1 != NULL ? chain1 : chain2;
+  return merged.next;
+}
+
+// Gives a given list a chain of nodes linked through their `next` pointers,
+// restoring the `previous` pointers and the tail along the way.
+static void relink(llist *list, node *chain) {
+  list->head = chain;
+  list->tail = NULL;
+  for (node *n = chain; n != NULL; n = n->next) {
+    n->previous = list->tail;
+    list->tail = n;
+  }
+  list->finger = NULL;
+}
+
+void llist_sort(llist *list) {
+  assert(list != NULL && "Failed to sort linked list because pointer was NULL");
+
+  // Bin i holds a sorted chain of 2^i nodes, or nothing. Every node is
+  // merged up through the bins like carrying in binary addition, which keeps
+  // merges balanced without knowing the length up front or allocating.
+  // Higher bins always hold earlier nodes, so the sort is stable.
+  node *bins[sizeof(size_t) * 8] = {NULL};
+  node *n = list->head;
+  while (n != NULL) {
+    node *chain = n;
+    n = n->next;
+    chain->next = NULL;
+
+    size_t i = 0;
+    for (; bins[i] != NULL; i++) {
+      chain = merge_chains(bins[i], chain);
+      bins[i] = NULL;
+    }
+    bins[i] = chain;
+  }
+
+  node *sorted = NULL;
+  for (size_t i = 0; i < sizeof(size_t) * 8; i++) {
+    if (bins[i] != NULL) {
+      sorted = merge_chains(bins[i], sorted);
+    }
+  }
+  relink(list, sorted);
+}
+
+void llist_merge(llist *dst, llist *src) {
+  assert(dst != NULL && src != NULL &&
+         "Failed to merge linked lists because at least one of the pointers "
+         "was NULL");
+  assert(dst != src &&
+         "Failed to merge linked lists because they were the same list");
+  assert(nodes_movable(dst, src) &&
+         "Failed to merge linked lists because they allocate nodes "
+         "differently");
+
+  relink(dst, merge_chains(dst->head, src->head));
+  dst->length += src->length;
+
+  src->head = NULL;
+  src->tail = NULL;
+  src->length = 0;
+  src->finger = NULL;
+}
+
+llist_stats llist_get_stats(llist *list) {
+  assert(list != NULL &&
+         "Failed to get linked list stats because pointer was NULL");
+  return list->stats;
+}
+
+void llist_reset_stats(llist *list) {
+  assert(list != NULL &&
+         "Failed to reset linked list stats because pointer was NULL");
+  list->stats.lookups = 0;
+  list->stats.finger_hits = 0;
+}
+
+llist_cursor llist_cursor_front(llist *list) {
+  assert(list != NULL &&
+         "Failed to get cursor for linked list because pointer was NULL");
+  llist_cursor cursor = {list, list->head, 0};
+  return cursor;
+}
+
+llist_cursor llist_cursor_back(llist *list) {
+  assert(list != NULL &&
+         "Failed to get cursor for linked list because pointer was NULL");
+  llist_cursor cursor = {list, list->tail,
+                         list->length > 0 ? list->length - 1 : 0};
+  return cursor;
+}
+
+llist_cursor llist_cursor_at(llist *list, size_t index) {
+  assert(list != NULL &&
+         "Failed to get cursor for linked list because pointer was NULL");
+  assert(index <= list->length &&
+         "Failed to get cursor for linked list because index was out of "
+         "bounds");
+  node *n = index == list->length ? NULL : get_node(list, index);
+  llist_cursor cursor = {list, n, index};
+  return cursor;
+}
+
+bool llist_cursor_at_end(llist_cursor *cursor) {
+  assert(cursor != NULL &&
+         "Failed to check if cursor was at end because pointer was NULL");
+  return cursor->node == NULL;
+}
+
+size_t llist_cursor_index(llist_cursor *cursor) {
+  assert(cursor != NULL &&
+         "Failed to get index of cursor because pointer was NULL");
+  return cursor->index;
+}
+
+void llist_cursor_next(llist_cursor *cursor) {
+  assert(cursor != NULL &&
+         "Failed to move cursor forward because pointer was NULL");
+  assert(cursor->node != NULL &&
+         "Failed to move cursor forward because it was at the end");
+  cursor->node = cursor->node->next;
+  cursor->index++;
+}
+
+void llist_cursor_prev(llist_cursor *cursor) {
+  assert(cursor != NULL &&
+         "Failed to move cursor backward because pointer was NULL");
+  assert(cursor->index > 0 &&
+         "Failed to move cursor backward because it was at the front");
+  cursor->node =
+      cursor->node != NULL ? cursor->node->previous : cursor->list->tail;
+  cursor->index--;
+}
+
+int llist_cursor_get(llist_cursor *cursor) {
+  assert(cursor != NULL &&
+         "Failed to get value at cursor because pointer was NULL");
+  assert(cursor->node != NULL &&
+         "Failed to get value at cursor because it was at the end");
+  return cursor->node->value;
+}
+
+void llist_cursor_set(llist_cursor *cursor, int value) {
+  assert(cursor != NULL &&
+         "Failed to set value at cursor because pointer was NULL");
+  assert(cursor->node != NULL &&
+         "Failed to set value at cursor because it was at the end");
+  cursor->node->value = value;
+}
+
+bool llist_cursor_insert_before(llist_cursor *cursor, int value) {
+  assert(cursor != NULL &&
+         "Failed to insert value before cursor because pointer was NULL");
+
+  node *n = node_create(cursor->list, value);
+  if (n == NULL) {
+    return false;
+  }
+  link_before(cursor->list, cursor->node, n, cursor->index);
+  cursor->index++;
+  return true;
+}
+
+bool llist_cursor_insert_after(llist_cursor *cursor, int value) {
+  assert(cursor != NULL &&
+         "Failed to insert value after cursor because pointer was NULL");
+  assert(cursor->node != NULL &&
+         "Failed to insert value after cursor because it was at the end");
+
+  node *n = node_create(cursor->list, value);
+  if (n == NULL) {
+    return false;
+  }
+  link_before(cursor->list, cursor->node->next, n, cursor->index + 1);
+  return true;
+}
+
+int llist_cursor_remove(llist_cursor *cursor) {
+  assert(cursor != NULL &&
+         "Failed to remove value at cursor because pointer was NULL");
+  assert(cursor->node != NULL &&
+         "Failed to remove value at cursor because it was at the end");
+
+  node *n = cursor->node;
+  cursor->node = n->next;
+  unlink_node(cursor->list, n, cursor->index);
+  int value = n->value;
+  node_destroy(cursor->list, n);
+  return value;
+}
+
 void llist_print(llist *list) {
   assert(list != NULL &&
          "Failed to print linked list because pointer was NULL");
@@ -26,10 +26,62 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "../allocator/allocator.h"
+
+// A doubly linked list. Every list remembers the last node it looked up by
+// index (its finger), and index-based lookups walk from whichever of the head,
+// the tail and the finger is closest, so sequential and near-sequential
+// access by index is amortized O(1).
 typedef struct llist llist;
 
+// Counters for the index-based lookups of a list.
+typedef struct llist_stats {
+  // Number of lookups that had to walk the list.
+  size_t lookups;
+  // Number of those lookups that started from the finger.
+  size_t finger_hits;
+} llist_stats;
+
+// A slab allocator for linked list nodes. Nodes are carved out of large
+// slabs and recycled through a free list, so that pushing and popping do not
+// call malloc and free for every value and nodes end up close together in
+// memory. A pool can be shared between several lists, in which case it must
+// outlive all of them.
+typedef struct llist_pool llist_pool;
+
+llist_pool *llist_pool_create(size_t nodes_per_slab);
+void llist_pool_destroy(llist_pool *pool);
+
 llist *llist_create();
+// Creates a list that allocates its nodes from a pool of its own. Clearing or
+// destroying the list releases whole slabs at once instead of freeing node
+// by node.
+llist *llist_create_pooled();
+// Creates a list that allocates its nodes from a given, possibly shared,
+// pool. Clearing the list gives all of its nodes back to the pool in O(1).
+llist *llist_create_with_pool(llist_pool *pool);
+// Creates a list that gets the memory for itself and its nodes from a given
+// allocator instead of malloc. The allocator is copied, but whatever its
+// context points to must outlive the list. With an arena, the list can be
+// dropped in O(1) by resetting the arena instead of calling llist_destroy.
+// Returns NULL if there is any allocation errors. `allocator` must satisfy
+// allocator_ok.
+llist *llist_create_with_allocator(const allocator *allocator);
+// Like llist_create_with_allocator, but the list itself and its nodes are
+// allocated from different allocators. This lets an allocator for objects of
+// one size, such as a fixed_pool sized for nodes, back the nodes while the
+// list comes from `list_allocator`. Both allocators must satisfy
+// allocator_ok.
+llist *llist_create_with_allocators(const allocator *list_allocator,
+                                    const allocator *node_allocator);
+// Creates a list holding a given array of values. Returns NULL if there is any
+// allocation errors.
 llist *llist_create_from_values(int *values, size_t length);
+// Like llist_create_from_values, but the list gets a pool of its own with a
+// first slab that fits all of the values, so that building it takes one
+// allocation for the nodes. Slabs allocated later, if the list keeps
+// growing, are of the same size as for llist_create_pooled.
+llist *llist_create_pooled_from_values(int *values, size_t length);
 void llist_destroy(llist *list);
 size_t llist_length(llist *list);
 bool llist_insert(llist *list, size_t index, int value);
@@ -47,6 +99,78 @@ bool llist_contains(llist *list, int value);
 bool llist_equals(llist *list1, llist *list2);
 bool llist_position(llist *list, int value, size_t *index);
 bool llist_empty(llist *list);
+// Appends a given array of values to the back of a list, linking them in a
+// single pass. Either all or none of the values are appended: returns false
+// and leaves the list unchanged if there is any allocation errors.
+bool llist_extend_from_array(llist *list, int *values, size_t length);
+// Copies the values of a list, front to back, into an array with room for
+// `capacity` values. Returns the number of values copied, which is the
+// smaller of the length of the list and `capacity`.
+size_t llist_to_array(llist *list, int *values, size_t capacity);
 void llist_print(llist *list);
 
+// The following functions move nodes between lists by relinking them, so they
+// never allocate. Lists involved must allocate their nodes in the same way:
+// either both from the same allocator or both from the same shared pool. A
+// list that owns its pool can not give its nodes away.
+
+// Moves all values of `src` onto the back of `dst` in O(1), leaving `src`
+// empty.
+void llist_concat(llist *dst, llist *src);
+// Moves `count` values starting at `src_index` in `src` into `dst` so that
+// the first of them ends up at `index`.
+void llist_splice(llist *dst, size_t index, llist *src, size_t src_index,
+                  size_t count);
+// Moves the values from `index` onwards out of a list and into a new list,
+// which is returned. Returns NULL if the new list could not be allocated, in
+// which case `list` is left unchanged.
+llist *llist_split_at(llist *list, size_t index);
+// Reverses the order of the values in a list.
+void llist_reverse(llist *list);
+// Sorts a list in ascending order using a stable, bottom-up merge sort that
+// runs in O(n log n) time and O(1) space.
+void llist_sort(llist *list);
+// Merges the values of sorted `src` into sorted `dst`, leaving `src` empty.
+// Equal values from `dst` come before those from `src`.
+void llist_merge(llist *dst, llist *src);
+llist_stats llist_get_stats(llist *list);
+void llist_reset_stats(llist *list);
+
+struct llist_node;
+
+// A position in a linked list: either at one of its values or at the end, one
+// past the last value. Cursors move, read, write, insert and remove in O(1),
+// unlike the index-based functions, which have to walk to the index first.
+// Modifying the list other than through a given cursor invalidates that
+// cursor. The fields are for internal use only.
+typedef struct llist_cursor {
+  llist *list;
+  struct llist_node *node;
+  size_t index;
+} llist_cursor;
+
+// Gets a cursor at the first value of a list, or at the end if it is empty.
+llist_cursor llist_cursor_front(llist *list);
+// Gets a cursor at the last value of a list, or at the end if it is empty.
+llist_cursor llist_cursor_back(llist *list);
+// Gets a cursor at a given index, which may be the length of the list to get
+// a cursor at the end.
+llist_cursor llist_cursor_at(llist *list, size_t index);
+bool llist_cursor_at_end(llist_cursor *cursor);
+size_t llist_cursor_index(llist_cursor *cursor);
+// Moves a cursor to the next value. The cursor must not be at the end.
+void llist_cursor_next(llist_cursor *cursor);
+// Moves a cursor to the previous value. Moving back from the end goes to the
+// last value. The cursor must not be at index 0.
+void llist_cursor_prev(llist_cursor *cursor);
+int llist_cursor_get(llist_cursor *cursor);
+void llist_cursor_set(llist_cursor *cursor, int value);
+// Inserts a value before the cursor, which stays at the same value. Inserting
+// at the end pushes the value onto the back of the list.
+bool llist_cursor_insert_before(llist_cursor *cursor, int value);
+// Inserts a value after the cursor, which must not be at the end.
+bool llist_cursor_insert_after(llist_cursor *cursor, int value);
+// Removes the value at the cursor, which then moves to the next value.
+int llist_cursor_remove(llist_cursor *cursor);
+
 #endif
@@ -0,0 +1,247 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pqueue.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../vector/vector.h"
+#include "../vector/vector_inline.h"
+
+typedef struct pqueue {
+  vector *heap;
+  size_t arity;
+} pqueue;
+
+// Moves the value at index i up until its parent is no larger.
+static void sift_up(pqueue *pq, size_t i) {
+  int *values = vector_data(pq->heap);
+  int value = values[i];
+  while (i > 0) {
+    size_t parent = (i - 1) / pq->arity;
+    if (values[parent] <= value) {
+      break;
+    }
+    values[i] = values[parent];
+    i = parent;
+  }
+  values[i] = value;
+}
+
+// Puts a given value at index i and moves it down until none of its children
+// are smaller. The hole is moved down rather than swapping at every level.
+static void sift_down(pqueue *pq, size_t i, int value) {
+  int *values = vector_data(pq->heap);
+  size_t length = vector_length(pq->heap);
+  while (true) {
+    size_t first = i * pq->arity + 1;
+    if (first >= length) {
+      break;
+    }
+    size_t last = first + pq->arity < length ? first + pq->arity : length;
+    size_t smallest = first;
+    for (size_t child = first + 1; child < last; child++) {
+      smallest = values[child] < values[smallest] ? child : smallest;
+    }
+    if (values[smallest] >= value) {
+      break;
+    }
+    values[i] = values[smallest];
+    i = smallest;
+  }
+  values[i] = value;
+}
+
+// Arranges the values of a given priority queue into a heap in O(n) time by
+// sifting down every node that has children, bottom up.
+static void heapify(pqueue *pq) {
+  size_t length = vector_length(pq->heap);
+  if (length < 2) {
+    return;
+  }
+  int *values = vector_data(pq->heap);
+  for (size_t i = (length - 2) / pq->arity + 1; i-- > 0;) {
+    sift_down(pq, i, values[i]);
+  }
+}
+
+pqueue *pqueue_create(size_t capacity, size_t arity) {
+  assert(arity >= 2 &&
+         "Failed to create priority queue because arity was less than 2");
+
+  pqueue *pq = malloc(sizeof(pqueue));
+  if (pq == NULL) {
+    return NULL;
+  }
+  pq->heap = vector_create(capacity);
+  if (pq->heap == NULL) {
+    free(pq);
+    return NULL;
+  }
+  pq->arity = arity;
+  return pq;
+}
+
+pqueue *pqueue_create_from_array(const int *values, size_t length,
+                                 size_t arity) {
+  assert((values != NULL || length == 0) &&
+         "Failed to create priority queue from array because value array "
+         "pointer was NULL");
+
+  pqueue *pq = pqueue_create(length > 0 ? length : 1, arity);
+  if (pq == NULL) {
+    return NULL;
+  }
+  if (length > 0 && !vector_push_many(pq->heap, values, length)) {
+    pqueue_destroy(pq);
+    return NULL;
+  }
+  heapify(pq);
+  return pq;
+}
+
+void pqueue_destroy(pqueue *pq) {
+  if (pq != NULL) {
+    vector_destroy(pq->heap);
+    free(pq);
+  }
+}
+
+size_t pqueue_length(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to get length of priority queue because pointer was NULL");
+  return vector_length(pq->heap);
+}
+
+bool pqueue_empty(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to check if priority queue is empty because pointer was "
+         "NULL");
+  return vector_empty(pq->heap);
+}
+
+size_t pqueue_arity(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to get arity of priority queue because pointer was NULL");
+  return pq->arity;
+}
+
+bool pqueue_push(pqueue *pq, int value) {
+  assert(pq != NULL &&
+         "Failed to push value onto priority queue because pointer was NULL");
+
+  if (!vector_push(pq->heap, value)) {
+    return false;
+  }
+  sift_up(pq, vector_length(pq->heap) - 1);
+  return true;
+}
+
+bool pqueue_push_many(pqueue *pq, const int *values, size_t count) {
+  assert(pq != NULL &&
+         "Failed to push values onto priority queue because queue pointer "
+         "was NULL");
+  assert((values != NULL || count == 0) &&
+         "Failed to push values onto priority queue because value array "
+         "pointer was NULL");
+
+  size_t old_length = vector_length(pq->heap);
+  if (!vector_push_many(pq->heap, values, count)) {
+    return false;
+  }
+  // Sifting each new value up costs O(k log n), rebuilding costs O(n)
+  if (count > old_length) {
+    heapify(pq);
+  } else {
+    for (size_t i = old_length; i < old_length + count; i++) {
+      sift_up(pq, i);
+    }
+  }
+  return true;
+}
+
+int pqueue_peek(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to peek at priority queue because pointer was NULL");
+  assert(!vector_empty(pq->heap) &&
+         "Failed to peek at priority queue because it was empty");
+  return vector_data(pq->heap)[0];
+}
+
+int pqueue_pop(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to pop value off priority queue because pointer was NULL");
+  assert(!vector_empty(pq->heap) &&
+         "Failed to pop value off priority queue because it was empty");
+
+  int top = vector_data(pq->heap)[0];
+  int last;
+  // The value is popped even if shrinking fails
+  vector_pop(pq->heap, &last);
+  if (!vector_empty(pq->heap)) {
+    sift_down(pq, 0, last);
+  }
+  return top;
+}
+
+int pqueue_push_pop(pqueue *pq, int value) {
+  assert(pq != NULL &&
+         "Failed to push and pop value on priority queue because pointer was "
+         "NULL");
+
+  if (vector_empty(pq->heap) || value <= vector_data(pq->heap)[0]) {
+    return value;
+  }
+  int top = vector_data(pq->heap)[0];
+  sift_down(pq, 0, value);
+  return top;
+}
+
+int pqueue_replace_top(pqueue *pq, int value) {
+  assert(pq != NULL &&
+         "Failed to replace top of priority queue because pointer was NULL");
+  assert(!vector_empty(pq->heap) &&
+         "Failed to replace top of priority queue because it was empty");
+
+  int top = vector_data(pq->heap)[0];
+  sift_down(pq, 0, value);
+  return top;
+}
+
+void pqueue_clear(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to clear priority queue because pointer was NULL");
+  vector_remove_range(pq->heap, 0, vector_length(pq->heap), NULL);
+}
+
+void pqueue_print(pqueue *pq) {
+  assert(pq != NULL &&
+         "Failed to print priority queue because pointer was NULL");
+
+  printf("[ ");
+  for (size_t i = 0; i < vector_length(pq->heap); i++) {
+    printf(i == 0 ? "%d" : ", %d", vector_data(pq->heap)[i]);
+  }
+  printf(" ]\n");
+}
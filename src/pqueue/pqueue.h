@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PQUEUE_H
+#define PQUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A priority queue of ints where the smallest value comes out first,
+// implemented as a d-ary heap stored in a vector. Every node has `arity`
+// children. A higher arity makes the heap shallower, so pushing is faster,
+// and siblings share cache lines; popping compares more children per level.
+// An arity of 4 is usually fastest.
+typedef struct pqueue pqueue;
+
+// Arity of a plain binary heap.
+#define PQUEUE_BINARY 2
+
+// Arity that tends to be fastest in practice.
+#define PQUEUE_DEFAULT_ARITY 4
+
+// Creates a new, empty priority queue with room for `capacity` values and
+// nodes with `arity` children each. If there is any allocation errors, then
+// NULL is returned. `capacity` must not be 0 and must satisfy
+// vector_capacity_ok, and `arity` must be at least 2. When a priority queue
+// is no longer needed, it should be freed by calling pqueue_destroy.
+pqueue *pqueue_create(size_t capacity, size_t arity);
+
+// Creates a new priority queue holding `length` values from a given array,
+// arranged into a heap in O(n) time. See pqueue_create for everything else.
+// `values` must not be NULL unless `length` is 0.
+pqueue *pqueue_create_from_array(const int *values, size_t length,
+                                 size_t arity);
+
+// Destroys a given priority queue, freeing the allocated memory. Does nothing
+// if `pq` is NULL.
+void pqueue_destroy(pqueue *pq);
+
+// Gets the number of values in a given priority queue. `pq` must not be NULL.
+size_t pqueue_length(pqueue *pq);
+
+// Checks that a given priority queue is empty. `pq` must not be NULL.
+bool pqueue_empty(pqueue *pq);
+
+// Gets the arity of a given priority queue. `pq` must not be NULL.
+size_t pqueue_arity(pqueue *pq);
+
+// Pushes a value onto a given priority queue in O(log n) time. Returns false
+// if the queue needs to grow but the growing operation fails. `pq` must not
+// be NULL.
+bool pqueue_push(pqueue *pq, int value);
+
+// Pushes `count` values from a given array onto a given priority queue. The
+// queue grows at most once, and if the new values outnumber the old ones,
+// the whole heap is rebuilt in O(n) instead of pushing one at a time.
+// Returns false if the queue needs to grow but the growing operation fails,
+// in which case the queue is left unchanged. `pq` must not be NULL and
+// `values` must not be NULL unless `count` is 0.
+bool pqueue_push_many(pqueue *pq, const int *values, size_t count);
+
+// Gets the smallest value in a given priority queue. `pq` must not be NULL
+// or empty.
+int pqueue_peek(pqueue *pq);
+
+// Pops the smallest value off a given priority queue in O(log n) time. `pq`
+// must not be NULL or empty.
+int pqueue_pop(pqueue *pq);
+
+// Pushes a value onto a given priority queue and then pops the smallest
+// value, in a single pass that never grows the queue. If the value is no
+// larger than the smallest value, it is returned right away. `pq` must not be
+// NULL.
+int pqueue_push_pop(pqueue *pq, int value);
+
+// Pops the smallest value off a given priority queue and then pushes a value,
+// in a single pass. Unlike pqueue_push_pop, the returned value may be larger
+// than the pushed one. `pq` must not be NULL or empty.
+int pqueue_replace_top(pqueue *pq, int value);
+
+// Removes all values from a given priority queue. `pq` must not be NULL.
+void pqueue_clear(pqueue *pq);
+
+void pqueue_print(pqueue *pq);
+
+#endif
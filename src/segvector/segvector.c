@@ -0,0 +1,283 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "segvector.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector.h"
+
+// Number of values in the first segment. Segment k holds FIRST_SEGMENT << k
+// values, so every segment is a whole number of ready words.
+#define FIRST_SEGMENT 64
+
+// Number of segments it takes to cover every index a size_t can hold.
+#define SEGMENTS (sizeof(size_t) * CHAR_BIT - 6)
+
+// Number of values covered by each word of a ready bitmap.
+#define WORD_BITS 64
+
+typedef struct segment {
+  int *values;
+  // One bit per value, set once the value has been published.
+  _Atomic uint64_t ready[];
+} segment;
+
+typedef struct segvector {
+  // Read-only after creation apart from segments being installed once, so
+  // shared freely
+  size_t capacity;
+  _Atomic(segment *) segments[SEGMENTS];
+
+  // Contended by every pushing thread, so kept away from the directory
+  alignas(CACHE_LINE) atomic_size_t length;
+} segvector;
+
+// Finds the segment holding a given index and the offset of the index in it.
+static size_t locate(size_t index, size_t *offset) {
+  size_t k = sizeof(unsigned long long) * CHAR_BIT - 1 -
+             __builtin_clzll(index / FIRST_SEGMENT + 1);
+  *offset = index - FIRST_SEGMENT * (((size_t)1 << k) - 1);
+  return k;
+}
+
+static size_t segment_size(size_t k) {
+  return (size_t)FIRST_SEGMENT << k;
+}
+
+// Gets segment k of a given segmented vector, allocating and installing it if
+// no thread has yet. Threads racing to install the same segment all allocate
+// one, but only the first to swap it in wins and the rest free theirs. Returns
+// NULL if allocation fails.
+static segment *get_segment(segvector *sv, size_t k) {
+  segment *s = atomic_load_explicit(&sv->segments[k], memory_order_acquire);
+  if (s != NULL) {
+    return s;
+  }
+
+  size_t size = segment_size(k);
+  size_t words = size / WORD_BITS;
+  size_t header = sizeof(segment) + words * sizeof(uint64_t);
+  if (!vector_capacity_ok(size) || size * sizeof(int) > SIZE_MAX - header) {
+    return NULL;
+  }
+  segment *new_segment = malloc(header + size * sizeof(int));
+  if (new_segment == NULL) {
+    return NULL;
+  }
+  new_segment->values = (int *)((char *)new_segment + header);
+  for (size_t i = 0; i < words; i++) {
+    atomic_init(&new_segment->ready[i], 0);
+  }
+
+  if (atomic_compare_exchange_strong_explicit(
+          &sv->segments[k], &s, new_segment, memory_order_acq_rel,
+          memory_order_acquire)) {
+    return new_segment;
+  }
+  // Lost the race, so `s` now holds the winner's segment
+  free(new_segment);
+  return s;
+}
+
+// Makes sure the segments holding `count` indices from `first` onwards are
+// all installed. `count` must not be 0. Returns false if a segment could not
+// be allocated.
+static bool install_segments(segvector *sv, size_t first, size_t count) {
+  size_t offset;
+  size_t last = locate(first + count - 1, &offset);
+  for (size_t k = locate(first, &offset); k <= last; k++) {
+    if (get_segment(sv, k) == NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Writes `count` values into the claimed indices from `first` onwards and
+// publishes them, one ready word at a time. The segments holding the indices
+// must be installed already.
+static void publish(segvector *sv, const int *values, size_t first,
+                    size_t count) {
+  while (count > 0) {
+    size_t offset;
+    size_t k = locate(first, &offset);
+    segment *s = atomic_load_explicit(&sv->segments[k], memory_order_acquire);
+
+    size_t bit = offset % WORD_BITS;
+    size_t n = WORD_BITS - bit < count ? WORD_BITS - bit : count;
+    memcpy(s->values + offset, values, n * sizeof(int));
+    uint64_t mask = n == WORD_BITS ? UINT64_MAX : ((uint64_t)1 << n) - 1;
+    // Releases the values written above to readers that see the bits
+    atomic_fetch_or_explicit(&s->ready[offset / WORD_BITS], mask << bit,
+                             memory_order_release);
+
+    values += n;
+    first += n;
+    count -= n;
+  }
+}
+
+segvector *segvector_create(size_t capacity) {
+  assert(vector_capacity_ok(capacity) &&
+         "Failed to create segmented vector because capacity was either 0 or "
+         "would cause an unsigned integer wrap");
+
+  segvector *sv = aligned_alloc(CACHE_LINE, sizeof(segvector));
+  if (sv == NULL) {
+    return NULL;
+  }
+  sv->capacity = capacity;
+  for (size_t k = 0; k < SEGMENTS; k++) {
+    atomic_init(&sv->segments[k], NULL);
+  }
+  atomic_init(&sv->length, 0);
+  return sv;
+}
+
+void segvector_destroy(segvector *sv) {
+  if (sv != NULL) {
+    for (size_t k = 0; k < SEGMENTS; k++) {
+      free(atomic_load_explicit(&sv->segments[k], memory_order_relaxed));
+    }
+    free(sv);
+  }
+}
+
+size_t segvector_capacity(segvector *sv) {
+  assert(sv != NULL &&
+         "Failed to get capacity of segmented vector because pointer was "
+         "NULL");
+  return sv->capacity;
+}
+
+size_t segvector_length(segvector *sv) {
+  assert(sv != NULL &&
+         "Failed to get length of segmented vector because pointer was NULL");
+
+  // Pushes onto a full segmented vector still bump the length
+  size_t length = atomic_load_explicit(&sv->length, memory_order_relaxed);
+  return length < sv->capacity ? length : sv->capacity;
+}
+
+bool segvector_push(segvector *sv, int value, size_t *index) {
+  assert(sv != NULL &&
+         "Failed to push value onto segmented vector because pointer was "
+         "NULL");
+
+  size_t claimed =
+      atomic_fetch_add_explicit(&sv->length, 1, memory_order_relaxed);
+  if (claimed >= sv->capacity) {
+    return false;
+  }
+
+  size_t offset;
+  size_t k = locate(claimed, &offset);
+  segment *s = get_segment(sv, k);
+  if (s == NULL) {
+    return false;
+  }
+  s->values[offset] = value;
+  atomic_fetch_or_explicit(&s->ready[offset / WORD_BITS],
+                           (uint64_t)1 << (offset % WORD_BITS),
+                           memory_order_release);
+  if (index != NULL) {
+    *index = claimed;
+  }
+  return true;
+}
+
+size_t segvector_push_many(segvector *sv, const int *values, size_t count,
+                           size_t *first) {
+  assert(sv != NULL &&
+         "Failed to push values onto segmented vector because vector pointer "
+         "was NULL");
+  assert((values != NULL || count == 0) &&
+         "Failed to push values onto segmented vector because value array "
+         "pointer was NULL");
+
+  // Claim no more than what is left, so that a batch that does not fit does
+  // not leave behind indices that are never published
+  size_t claimed = atomic_load_explicit(&sv->length, memory_order_relaxed);
+  size_t n;
+  do {
+    if (claimed >= sv->capacity) {
+      return 0;
+    }
+    n = sv->capacity - claimed < count ? sv->capacity - claimed : count;
+  } while (!atomic_compare_exchange_weak_explicit(
+      &sv->length, &claimed, claimed + n, memory_order_relaxed,
+      memory_order_relaxed));
+
+  // Every segment is installed before any value is published, so that a
+  // failed allocation publishes none of the batch rather than part of it
+  if (n > 0 && !install_segments(sv, claimed, n)) {
+    return 0;
+  }
+  publish(sv, values, claimed, n);
+  if (first != NULL) {
+    *first = claimed;
+  }
+  return n;
+}
+
+int *segvector_at(segvector *sv, size_t index) {
+  assert(sv != NULL &&
+         "Failed to get value pointer of segmented vector because pointer "
+         "was NULL");
+
+  if (index >= sv->capacity) {
+    return NULL;
+  }
+  size_t offset;
+  size_t k = locate(index, &offset);
+  segment *s = atomic_load_explicit(&sv->segments[k], memory_order_acquire);
+  if (s == NULL) {
+    return NULL;
+  }
+  uint64_t word = atomic_load_explicit(&s->ready[offset / WORD_BITS],
+                                       memory_order_acquire);
+  if ((word >> (offset % WORD_BITS) & 1) == 0) {
+    return NULL;
+  }
+  return &s->values[offset];
+}
+
+bool segvector_get(segvector *sv, size_t index, int *value) {
+  assert(sv != NULL && value != NULL &&
+         "Failed to get value from segmented vector because at least one of "
+         "the pointers was NULL");
+
+  int *pointer = segvector_at(sv, index);
+  if (pointer == NULL) {
+    return false;
+  }
+  *value = *pointer;
+  return true;
+}
@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SEGVECTOR_H
+#define SEGVECTOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// An append-only array of ints that any number of threads can push onto and
+// read from at the same time without locks. Values live in segments of
+// exponentially growing size that are allocated as needed and never move, so
+// unlike a vector, pointers to values stay valid for the lifetime of the
+// segmented vector. Pushing claims an index with a single atomic increment,
+// and reading an index never waits: a value is either published, in which
+// case it is returned, or it is not yet, in which case the read fails.
+typedef struct segvector segvector;
+
+// Creates a new, empty segmented vector that can hold up to `capacity`
+// values. No values are allocated until they are pushed. Returns NULL if
+// there is any allocation errors. `capacity` must satisfy vector_capacity_ok.
+// When a segmented vector is no longer needed, it should be freed by calling
+// segvector_destroy.
+segvector *segvector_create(size_t capacity);
+
+// Destroys a given segmented vector, freeing the allocated memory. Does
+// nothing if `sv` is NULL. No thread may use the segmented vector any longer.
+void segvector_destroy(segvector *sv);
+
+// Gets the maximum number of values a given segmented vector can hold. `sv`
+// must not be NULL.
+size_t segvector_capacity(segvector *sv);
+
+// Gets the number of indices claimed by pushes so far. Values at indices
+// below it may still be in the middle of being published by other threads,
+// and indices claimed by pushes that failed to allocate a segment are never
+// published at all, leaving holes that reads fail on forever. `sv` must not
+// be NULL.
+size_t segvector_length(segvector *sv);
+
+// Pushes a value onto the end of a given segmented vector and publishes it to
+// all threads. If `index` is not NULL, the index the value ended up at is put
+// into it. Returns false if the segmented vector is full or if allocating a
+// new segment fails. In the latter case the claimed index stays counted by
+// segvector_length but is never published. `sv` must not be NULL.
+bool segvector_push(segvector *sv, int value, size_t *index);
+
+// Pushes `count` values from a given array onto the end of a given segmented
+// vector, claiming all of their indices at once so that they end up next to
+// each other. If the segmented vector can not fit all of them, as many as fit
+// are pushed. If `first` is not NULL and any values are pushed, the index of
+// the first value is put into it. Returns the number of values pushed. All
+// segments the values need are allocated before any value is published, so
+// if an allocation fails, none of them are and 0 is returned, but the claimed
+// indices stay counted by segvector_length and are never published. `sv`
+// must not be NULL and `values` must not be NULL unless `count` is 0.
+size_t segvector_push_many(segvector *sv, const int *values, size_t count,
+                           size_t *first);
+
+// Gets the value at a given index of a given segmented vector and puts it
+// into `value`. Returns false if no value has been published at that index
+// yet. Never waits for other threads. `sv` and `value` must not be NULL.
+bool segvector_get(segvector *sv, size_t index, int *value);
+
+// Gets a pointer to the value at a given index of a given segmented vector,
+// which stays valid until the segmented vector is destroyed. Returns NULL if
+// no value has been published at that index yet. `sv` must not be NULL.
+int *segvector_at(segvector *sv, size_t index);
+
+#endif
@@ -0,0 +1,225 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sortedset.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector_inline.h"
+
+// Number of searches interleaved by the batched lookups.
+#define BATCH_SIZE 8
+
+typedef struct sortedset {
+  // The values in Eytzinger order, 1-indexed: the children of the value at
+  // index k are at 2k and 2k + 1. Index 0 is unused, which puts the first
+  // value at the start of a cache line in the second slot.
+  int *values;
+  // The position of each value in sorted order, indexed like `values`.
+  size_t *ranks;
+  size_t length;
+} sortedset;
+
+// Allocates `size` bytes aligned to a cache line.
+static void *alloc_aligned(size_t size) {
+  size_t rounded = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+  return aligned_alloc(CACHE_LINE, rounded > 0 ? rounded : CACHE_LINE);
+}
+
+// Fills `set` with the values of `sorted` by walking the implicit tree in
+// order. Returns the index of the next value of `sorted` to place.
+static size_t fill(sortedset *set, const int *sorted, size_t i, size_t k) {
+  if (k <= set->length) {
+    i = fill(set, sorted, i, 2 * k);
+    set->values[k] = sorted[i];
+    set->ranks[k] = i;
+    i = fill(set, sorted, i + 1, 2 * k + 1);
+  }
+  return i;
+}
+
+// Gets the Eytzinger index of the smallest value that is greater than or
+// equal to `value`, or 0 if there is none. The descent always goes all the
+// way down, turning left or right without a branch, and the index finally
+// backtracks to the last left turn.
+static size_t lower_bound_index(sortedset *set, int value) {
+  size_t k = 1;
+  while (k <= set->length) {
+    // The 16 values 4 levels down are adjacent and share a cache line
+    __builtin_prefetch(set->values + k * CACHE_LINE / sizeof(int));
+    k = 2 * k + (set->values[k] < value);
+  }
+  // Strip the trailing right turns plus the final left turn
+  k >>= __builtin_ffsll(~k);
+  return k;
+}
+
+sortedset *sortedset_create_from_vector(vector *vec) {
+  assert(vec != NULL &&
+         "Failed to create sorted set from vector because pointer was NULL");
+
+  size_t capacity = vector_length(vec) > 0 ? vector_length(vec) : 1;
+  sortedset *set = malloc(sizeof(sortedset));
+  vector *sorted = vector_create(capacity);
+  if (set == NULL || sorted == NULL || !vector_extend_from(sorted, vec) ||
+      !vector_sort(sorted)) {
+    free(set);
+    vector_destroy(sorted);
+    return NULL;
+  }
+
+  // Drop duplicates
+  int *values = vector_data(sorted);
+  size_t length = 0;
+  for (size_t i = 0; i < vector_length(sorted); i++) {
+    if (length == 0 || values[i] != values[length - 1]) {
+      values[length++] = values[i];
+    }
+  }
+
+  set->length = length;
+  set->ranks = NULL;
+  set->values = alloc_aligned((length + 1) * sizeof(int));
+  set->ranks = alloc_aligned((length + 1) * sizeof(size_t));
+  if (set->values == NULL || set->ranks == NULL) {
+    vector_destroy(sorted);
+    sortedset_destroy(set);
+    return NULL;
+  }
+  fill(set, values, 0, 1);
+
+  vector_destroy(sorted);
+  return set;
+}
+
+void sortedset_destroy(sortedset *set) {
+  if (set != NULL) {
+    free(set->values);
+    free(set->ranks);
+    free(set);
+  }
+}
+
+size_t sortedset_length(sortedset *set) {
+  assert(set != NULL &&
+         "Failed to get length of sorted set because pointer was NULL");
+  return set->length;
+}
+
+bool sortedset_contains(sortedset *set, int value) {
+  assert(set != NULL &&
+         "Failed to check if sorted set contains value because pointer was "
+         "NULL");
+  size_t k = lower_bound_index(set, value);
+  return k != 0 && set->values[k] == value;
+}
+
+bool sortedset_lower_bound(sortedset *set, int value, int *result) {
+  assert(set != NULL &&
+         "Failed to find lower bound in sorted set because set pointer was "
+         "NULL");
+  assert(result != NULL &&
+         "Failed to return lower bound in sorted set because result pointer "
+         "was NULL");
+  size_t k = lower_bound_index(set, value);
+  if (k == 0) {
+    return false;
+  }
+  *result = set->values[k];
+  return true;
+}
+
+size_t sortedset_rank(sortedset *set, int value) {
+  assert(set != NULL &&
+         "Failed to get rank in sorted set because pointer was NULL");
+  size_t k = lower_bound_index(set, value);
+  return k == 0 ? set->length : set->ranks[k];
+}
+
+// Runs lower_bound_index for up to BATCH_SIZE values at once, one level at a
+// time, so that the loads of all searches are in flight together.
+static void lower_bound_batch(sortedset *set, const int *values, size_t count,
+                              size_t *indices) {
+  for (size_t q = 0; q < count; q++) {
+    indices[q] = 1;
+  }
+
+  bool searching = true;
+  while (searching) {
+    searching = false;
+    for (size_t q = 0; q < count; q++) {
+      size_t k = indices[q];
+      if (k <= set->length) {
+        __builtin_prefetch(set->values + k * CACHE_LINE / sizeof(int));
+        indices[q] = 2 * k + (set->values[k] < values[q]);
+        searching = true;
+      }
+    }
+  }
+
+  for (size_t q = 0; q < count; q++) {
+    indices[q] >>= __builtin_ffsll(~indices[q]);
+  }
+}
+
+void sortedset_contains_many(sortedset *set, const int *values, size_t count,
+                             bool *results) {
+  assert(set != NULL &&
+         "Failed to check if sorted set contains values because set pointer "
+         "was NULL");
+  assert(((values != NULL && results != NULL) || count == 0) &&
+         "Failed to check if sorted set contains values because value or "
+         "result array pointer was NULL");
+
+  size_t indices[BATCH_SIZE];
+  for (size_t i = 0; i < count; i += BATCH_SIZE) {
+    size_t batch = count - i < BATCH_SIZE ? count - i : BATCH_SIZE;
+    lower_bound_batch(set, values + i, batch, indices);
+    for (size_t q = 0; q < batch; q++) {
+      size_t k = indices[q];
+      results[i + q] = k != 0 && set->values[k] == values[i + q];
+    }
+  }
+}
+
+void sortedset_rank_many(sortedset *set, const int *values, size_t count,
+                         size_t *ranks) {
+  assert(set != NULL &&
+         "Failed to get ranks in sorted set because set pointer was NULL");
+  assert(((values != NULL && ranks != NULL) || count == 0) &&
+         "Failed to get ranks in sorted set because value or rank array "
+         "pointer was NULL");
+
+  size_t indices[BATCH_SIZE];
+  for (size_t i = 0; i < count; i += BATCH_SIZE) {
+    size_t batch = count - i < BATCH_SIZE ? count - i : BATCH_SIZE;
+    lower_bound_batch(set, values + i, batch, indices);
+    for (size_t q = 0; q < batch; q++) {
+      size_t k = indices[q];
+      ranks[i + q] = k == 0 ? set->length : set->ranks[k];
+    }
+  }
+}
@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SORTEDSET_H
+#define SORTEDSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../vector/vector.h"
+
+// An immutable set of ints for fast lookups. The values are stored in
+// Eytzinger (breadth-first binary tree) order, so the first levels of every
+// search share a few cache lines and the next levels can be prefetched, and
+// lookups run without any hard-to-predict branches.
+typedef struct sortedset sortedset;
+
+// Creates a new sorted set holding the distinct values of a given vector.
+// The vector is not modified and need not be sorted. If there is any
+// allocation errors, then NULL is returned. When a sorted set created using
+// this function is no longer needed, it should be freed by calling the
+// sortedset_destroy function to avoid memory leaking. `vec` must not be NULL.
+sortedset *sortedset_create_from_vector(vector *vec);
+
+// Destroys a given sorted set, freeing the allocated memory. Does nothing if
+// `set` is NULL.
+void sortedset_destroy(sortedset *set);
+
+// Gets the number of values in a given sorted set. `set` must not be NULL.
+size_t sortedset_length(sortedset *set);
+
+// Checks if a given sorted set contains a given value. `set` must not be
+// NULL.
+bool sortedset_contains(sortedset *set, int value);
+
+// Finds the smallest value in a given sorted set that is greater than or
+// equal to a given value. Returns true and puts the value into `result` if
+// there is one and returns false otherwise. `set` and `result` must not be
+// NULL.
+bool sortedset_lower_bound(sortedset *set, int value, int *result);
+
+// Gets the number of values in a given sorted set that are less than a given
+// value. `set` must not be NULL.
+size_t sortedset_rank(sortedset *set, int value);
+
+// Checks if a given sorted set contains each of `count` values, putting the
+// answer for `values[i]` into `results[i]`. The searches are interleaved so
+// that the memory latency of one search is hidden behind the others, which
+// makes this much faster than calling sortedset_contains in a loop. `set`
+// must not be NULL and `values` and `results` must not be NULL unless
+// `count` is 0.
+void sortedset_contains_many(sortedset *set, const int *values, size_t count,
+                             bool *results);
+
+// Gets the rank of each of `count` values, putting the rank of `values[i]`
+// into `ranks[i]`. See sortedset_rank and sortedset_contains_many.
+void sortedset_rank_many(sortedset *set, const int *values, size_t count,
+                         size_t *ranks);
+
+#endif
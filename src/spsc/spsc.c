@@ -0,0 +1,212 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "spsc.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cpu/cpu.h"
+#include "../vector/vector.h"
+
+// The producer and the consumer each get cache lines of their own, so that
+// one thread writing its index does not keep evicting what the other thread
+// is reading. Indices count values ever pushed and popped and are only masked
+// when used, so that `tail - head` is always the length.
+typedef struct spsc {
+  // Read-only after creation, so shared freely
+  alignas(CACHE_LINE) int *values;
+  size_t mask;
+
+  // Written by the consumer
+  alignas(CACHE_LINE) atomic_size_t head;
+  // The consumer's last known value of `tail`. Only when the queue looks
+  // empty according to it does the consumer read `tail` again.
+  size_t cached_tail;
+
+  // Written by the producer
+  alignas(CACHE_LINE) atomic_size_t tail;
+  // The producer's last known value of `head`. Only when the queue looks full
+  // according to it does the producer read `head` again.
+  size_t cached_head;
+} spsc;
+
+// Gets the number of free slots the producer can fill, re-reading `head` if
+// fewer than `wanted` appear to be free.
+static size_t free_slots(spsc *q, size_t tail, size_t wanted) {
+  size_t capacity = q->mask + 1;
+  size_t free = capacity - (tail - q->cached_head);
+  if (free < wanted) {
+    q->cached_head = atomic_load_explicit(&q->head, memory_order_acquire);
+    free = capacity - (tail - q->cached_head);
+  }
+  return free;
+}
+
+// Gets the number of values the consumer can take, re-reading `tail` if fewer
+// than `wanted` appear to be available.
+static size_t used_slots(spsc *q, size_t head, size_t wanted) {
+  size_t used = q->cached_tail - head;
+  if (used < wanted) {
+    q->cached_tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    used = q->cached_tail - head;
+  }
+  return used;
+}
+
+spsc *spsc_create(size_t capacity) {
+  assert(vector_capacity_ok(capacity) &&
+         "Failed to create SPSC queue because capacity was either 0 or would "
+         "cause an unsigned integer wrap");
+
+  size_t rounded = 1;
+  while (rounded < capacity) {
+    if (rounded > SIZE_MAX / 2) {
+      return NULL;
+    }
+    rounded *= 2;
+  }
+  if (!vector_capacity_ok(rounded)) {
+    return NULL;
+  }
+
+  spsc *q = aligned_alloc(CACHE_LINE, sizeof(spsc));
+  if (q == NULL) {
+    return NULL;
+  }
+  q->values = malloc(rounded * sizeof(int));
+  if (q->values == NULL) {
+    free(q);
+    return NULL;
+  }
+  q->mask = rounded - 1;
+  atomic_init(&q->head, 0);
+  q->cached_tail = 0;
+  atomic_init(&q->tail, 0);
+  q->cached_head = 0;
+  return q;
+}
+
+void spsc_destroy(spsc *q) {
+  if (q != NULL) {
+    free(q->values);
+    free(q);
+  }
+}
+
+size_t spsc_capacity(spsc *q) {
+  assert(q != NULL &&
+         "Failed to get capacity of SPSC queue because pointer was NULL");
+  return q->mask + 1;
+}
+
+size_t spsc_length(spsc *q) {
+  assert(q != NULL &&
+         "Failed to get length of SPSC queue because pointer was NULL");
+
+  // Load head first, so that the tail loaded afterwards is never behind it
+  size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+  return tail - head;
+}
+
+bool spsc_push(spsc *q, int value) {
+  assert(q != NULL &&
+         "Failed to push value onto SPSC queue because pointer was NULL");
+
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (free_slots(q, tail, 1) == 0) {
+    return false;
+  }
+  q->values[tail & q->mask] = value;
+  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+bool spsc_pop(spsc *q, int *value) {
+  assert(q != NULL && value != NULL &&
+         "Failed to pop value off SPSC queue because at least one of the "
+         "pointers was NULL");
+
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if (used_slots(q, head, 1) == 0) {
+    return false;
+  }
+  *value = q->values[head & q->mask];
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  return true;
+}
+
+size_t spsc_push_many(spsc *q, const int *values, size_t count) {
+  assert(q != NULL &&
+         "Failed to push values onto SPSC queue because queue pointer was "
+         "NULL");
+  assert((values != NULL || count == 0) &&
+         "Failed to push values onto SPSC queue because value array pointer "
+         "was NULL");
+
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  size_t free = free_slots(q, tail, count);
+  if (count > free) {
+    count = free;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  // Copy up to the end of the ring, then wrap around to its start
+  size_t start = tail & q->mask;
+  size_t first = q->mask + 1 - start < count ? q->mask + 1 - start : count;
+  memcpy(q->values + start, values, first * sizeof(int));
+  memcpy(q->values, values + first, (count - first) * sizeof(int));
+  atomic_store_explicit(&q->tail, tail + count, memory_order_release);
+  return count;
+}
+
+size_t spsc_pop_many(spsc *q, int *values, size_t count) {
+  assert(q != NULL &&
+         "Failed to pop values off SPSC queue because queue pointer was NULL");
+  assert((values != NULL || count == 0) &&
+         "Failed to pop values off SPSC queue because value array pointer was "
+         "NULL");
+
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  size_t used = used_slots(q, head, count);
+  if (count > used) {
+    count = used;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  // Copy up to the end of the ring, then wrap around to its start
+  size_t start = head & q->mask;
+  size_t first = q->mask + 1 - start < count ? q->mask + 1 - start : count;
+  memcpy(values, q->values + start, first * sizeof(int));
+  memcpy(values + first, q->values, (count - first) * sizeof(int));
+  atomic_store_explicit(&q->head, head + count, memory_order_release);
+  return count;
+}
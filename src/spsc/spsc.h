@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A bounded, lock-free queue for passing values from exactly one producer
+// thread to exactly one consumer thread. Only the producer may push and only
+// the consumer may pop; neither ever blocks or takes a lock. Pushing fails
+// when the queue is full and popping fails when it is empty, so callers
+// decide whether to spin, yield or do other work in the meantime.
+typedef struct spsc spsc;
+
+// Creates a new queue with room for at least `capacity` values. The capacity
+// is rounded up to a power of two. Returns NULL if there is any allocation
+// errors or if the rounded capacity is too large. `capacity` must not be 0
+// and must satisfy vector_capacity_ok.
+spsc *spsc_create(size_t capacity);
+
+// Destroys a given queue, freeing the allocated memory. Does nothing if `q` is
+// NULL. Neither thread may use the queue any longer.
+void spsc_destroy(spsc *q);
+
+// Gets the capacity of a given queue. `q` must not be NULL.
+size_t spsc_capacity(spsc *q);
+
+// Gets the number of values in a given queue. Unless called from the only
+// thread using the queue, this is only a snapshot that may be out of date by
+// the time it is returned. `q` must not be NULL.
+size_t spsc_length(spsc *q);
+
+// Pushes a value onto the back of a given queue. Returns false if the queue is
+// full. Must only be called by the producer. `q` must not be NULL.
+bool spsc_push(spsc *q, int value);
+
+// Pops a value off the front of a given queue into `value`. Returns false if
+// the queue is empty. Must only be called by the consumer. `q` and `value`
+// must not be NULL.
+bool spsc_pop(spsc *q, int *value);
+
+// Pushes as many as possible of `count` values from a given array onto the
+// back of a given queue, publishing them to the consumer all at once. Returns
+// the number of values pushed. Must only be called by the producer. `q` must
+// not be NULL and `values` must not be NULL unless `count` is 0.
+size_t spsc_push_many(spsc *q, const int *values, size_t count);
+
+// Pops up to `count` values off the front of a given queue into a given array,
+// handing their slots back to the producer all at once. Returns the number of
+// values popped. Must only be called by the consumer. `q` must not be NULL and
+// `values` must not be NULL unless `count` is 0.
+size_t spsc_pop_many(spsc *q, int *values, size_t count);
+
+#endif
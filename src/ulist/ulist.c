@@ -0,0 +1,437 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ulist.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cpu/cpu.h"
+
+// Size of a node in bytes.
+#define NODE_SIZE (2 * CACHE_LINE)
+
+// Number of values that fit in a node next to its links and count.
+#define NODE_CAPACITY                                                          \
+  ((NODE_SIZE - 2 * sizeof(void *) - sizeof(uint32_t)) / sizeof(int))
+
+typedef struct node {
+  struct node *next;
+  struct node *previous;
+  uint32_t count;
+  int values[NODE_CAPACITY];
+} node;
+
+typedef struct ulist {
+  node *head;
+  node *tail;
+  size_t length;
+} ulist;
+
+static node *node_create() {
+  node *n = aligned_alloc(CACHE_LINE, sizeof(node));
+  if (n == NULL) {
+    return NULL;
+  }
+
+  n->next = NULL;
+  n->previous = NULL;
+  n->count = 0;
+  return n;
+}
+
+// Links a new node `n` into a given list right after `previous`, or at the
+// front if `previous` is NULL.
+static void link_after(ulist *list, node *previous, node *n) {
+  node *next = previous != NULL ? previous->next : list->head;
+  n->previous = previous;
+  n->next = next;
+  if (previous != NULL) {
+    previous->next = n;
+  } else {
+    list->head = n;
+  }
+  if (next != NULL) {
+    next->previous = n;
+  } else {
+    list->tail = n;
+  }
+}
+
+// Unlinks a node from a given list and frees it.
+static void unlink_node(ulist *list, node *n) {
+  if (n->previous != NULL) {
+    n->previous->next = n->next;
+  } else {
+    list->head = n->next;
+  }
+  if (n->next != NULL) {
+    n->next->previous = n->previous;
+  } else {
+    list->tail = n->previous;
+  }
+  free(n);
+}
+
+// Gets the node holding the value at a given index, walking from whichever end
+// is closer, and puts the position of the value within the node into
+// `offset`.
+static node *get_node(ulist *list, size_t index, size_t *offset) {
+  node *n;
+  if (index <= list->length / 2) {
+    // Index closer to head than tail
+    n = list->head;
+    while (index >= n->count) {
+      index -= n->count;
+      n = n->next;
+    }
+  } else {
+    // Index closer to tail than head
+    n = list->tail;
+    size_t start = list->length - n->count;
+    while (index < start) {
+      n = n->previous;
+      start -= n->count;
+    }
+    index -= start;
+  }
+
+  *offset = index;
+  return n;
+}
+
+ulist *ulist_create() {
+  ulist *list = malloc(sizeof(ulist));
+  if (list == NULL) {
+    return NULL;
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  return list;
+}
+
+ulist *ulist_create_from_values(int *values, size_t length) {
+  assert(values != NULL &&
+         "Failed to create unrolled list from values because value array "
+         "pointer was NULL");
+
+  ulist *list = ulist_create();
+  if (list == NULL) {
+    return NULL;
+  }
+
+  // Fill nodes completely, one block copy per node
+  for (size_t i = 0; i < length; i += NODE_CAPACITY) {
+    node *n = node_create();
+    if (n == NULL) {
+      ulist_destroy(list);
+      return NULL;
+    }
+    n->count = length - i < NODE_CAPACITY ? length - i : NODE_CAPACITY;
+    memcpy(n->values, values + i, n->count * sizeof(int));
+    link_after(list, list->tail, n);
+    list->length += n->count;
+  }
+  return list;
+}
+
+void ulist_destroy(ulist *list) {
+  if (list != NULL) {
+    ulist_clear(list);
+    free(list);
+  }
+}
+
+size_t ulist_length(ulist *list) {
+  assert(list != NULL &&
+         "Failed to get length of unrolled list because pointer was NULL");
+  return list->length;
+}
+
+bool ulist_insert(ulist *list, size_t index, int value) {
+  assert(list != NULL &&
+         "Failed to insert value into unrolled list because pointer was NULL");
+  assert(index <= list->length &&
+         "Failed to insert value into unrolled list because index was out of "
+         "bounds");
+
+  node *n;
+  size_t offset;
+  if (list->head == NULL) {
+    // No elements in list
+    n = node_create();
+    if (n == NULL) {
+      return false;
+    }
+    link_after(list, NULL, n);
+    offset = 0;
+  } else if (index == list->length) {
+    n = list->tail;
+    offset = n->count;
+  } else {
+    n = get_node(list, index, &offset);
+  }
+
+  if (n->count == NODE_CAPACITY) {
+    node *split = node_create();
+    if (split == NULL) {
+      return false;
+    }
+
+    if (offset == NODE_CAPACITY) {
+      // Appending to a full node, so start a fresh one instead of splitting
+      link_after(list, n, split);
+      n = split;
+      offset = 0;
+    } else if (offset == 0 && n->previous == NULL) {
+      // Prepending to a full head, so start a fresh one before it
+      link_after(list, NULL, split);
+      n = split;
+    } else {
+      // Move the upper half into the new node
+      size_t half = NODE_CAPACITY / 2;
+      split->count = NODE_CAPACITY - half;
+      memcpy(split->values, n->values + half, split->count * sizeof(int));
+      n->count = half;
+      link_after(list, n, split);
+      if (offset > half) {
+        n = split;
+        offset -= half;
+      }
+    }
+  }
+
+  memmove(n->values + offset + 1, n->values + offset,
+          (n->count - offset) * sizeof(int));
+  n->values[offset] = value;
+  n->count++;
+  list->length++;
+  return true;
+}
+
+int ulist_remove(ulist *list, size_t index) {
+  assert(list != NULL &&
+         "Failed to remove value from unrolled list because pointer was NULL");
+  assert(index < list->length &&
+         "Failed to remove value from unrolled list because index was out of "
+         "bounds");
+
+  size_t offset;
+  node *n = get_node(list, index, &offset);
+  int value = n->values[offset];
+  n->count--;
+  memmove(n->values + offset, n->values + offset + 1,
+          (n->count - offset) * sizeof(int));
+  list->length--;
+
+  if (n->count == 0) {
+    unlink_node(list, n);
+  } else if (n->count < NODE_CAPACITY / 2) {
+    // Merge with a neighbour if both fit in one node
+    if (n->next != NULL && n->count + n->next->count <= NODE_CAPACITY) {
+      node *next = n->next;
+      memcpy(n->values + n->count, next->values, next->count * sizeof(int));
+      n->count += next->count;
+      unlink_node(list, next);
+    } else if (n->previous != NULL &&
+               n->previous->count + n->count <= NODE_CAPACITY) {
+      node *previous = n->previous;
+      memcpy(previous->values + previous->count, n->values,
+             n->count * sizeof(int));
+      previous->count += n->count;
+      unlink_node(list, n);
+    }
+  }
+  return value;
+}
+
+bool ulist_push_back(ulist *list, int value) {
+  assert(list != NULL && "Failed to push value onto back of unrolled list "
+                         "because pointer was NULL");
+  return ulist_insert(list, list->length, value);
+}
+
+int ulist_back(ulist *list) {
+  assert(list != NULL && "Failed to get back value from unrolled list because "
+                         "pointer was NULL");
+  return ulist_get(list, list->length - 1);
+}
+
+int ulist_pop_back(ulist *list) {
+  assert(list != NULL && "Failed to pop value from back of unrolled list "
+                         "because pointer was NULL");
+  return ulist_remove(list, list->length - 1);
+}
+
+bool ulist_push_front(ulist *list, int value) {
+  assert(list != NULL && "Failed to push value onto front of unrolled list "
+                         "because pointer was NULL");
+  return ulist_insert(list, 0, value);
+}
+
+int ulist_front(ulist *list) {
+  assert(list != NULL && "Failed to get front value from unrolled list "
+                         "because pointer was NULL");
+  return ulist_get(list, 0);
+}
+
+int ulist_pop_front(ulist *list) {
+  assert(list != NULL && "Failed to pop value from front of unrolled list "
+                         "because pointer was NULL");
+  return ulist_remove(list, 0);
+}
+
+void ulist_set(ulist *list, size_t index, int value) {
+  assert(list != NULL &&
+         "Failed to set value in unrolled list because pointer was NULL");
+  assert(index < list->length &&
+         "Failed to set value in unrolled list because index was out of "
+         "bounds");
+
+  size_t offset;
+  node *n = get_node(list, index, &offset);
+  n->values[offset] = value;
+}
+
+int ulist_get(ulist *list, size_t index) {
+  assert(list != NULL &&
+         "Failed to get value from unrolled list because pointer was NULL");
+  assert(index < list->length &&
+         "Failed to get value from unrolled list because index was out of "
+         "bounds");
+
+  size_t offset;
+  node *n = get_node(list, index, &offset);
+  return n->values[offset];
+}
+
+void ulist_clear(ulist *list) {
+  assert(list != NULL &&
+         "Failed to clear unrolled list because pointer was NULL");
+
+  node *n = list->head;
+  node *tmp;
+  while (n != NULL) {
+    tmp = n;
+    n = n->next;
+    free(tmp);
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+}
+
+bool ulist_contains(ulist *list, int value) {
+  assert(list != NULL && "Failed to check if unrolled list contains value "
+                         "because pointer was NULL");
+  size_t index;
+  return ulist_position(list, value, &index);
+}
+
+bool ulist_equals(ulist *list1, ulist *list2) {
+  assert((list1 != NULL || list2 != NULL) &&
+         "Failed to compare unrolled lists because at least one of the "
+         "pointers was NULL");
+
+  if (list1 == list2) {
+    // The pointers refer to the same object
+    return true;
+  }
+
+  if (list1->length != list2->length) {
+    return false;
+  }
+
+  // Nodes of the two lists need not line up, so compare the longest run that
+  // is left in both current nodes at a time
+  node *n1 = list1->head;
+  node *n2 = list2->head;
+  size_t offset1 = 0;
+  size_t offset2 = 0;
+  while (n1 != NULL) {
+    size_t left1 = n1->count - offset1;
+    size_t left2 = n2->count - offset2;
+    size_t num = left1 < left2 ? left1 : left2;
+    if (memcmp(n1->values + offset1, n2->values + offset2,
+               num * sizeof(int)) != 0) {
+      return false;
+    }
+    offset1 += num;
+    offset2 += num;
+    if (offset1 == n1->count) {
+      n1 = n1->next;
+      offset1 = 0;
+    }
+    if (offset2 == n2->count) {
+      n2 = n2->next;
+      offset2 = 0;
+    }
+  }
+  return true;
+}
+
+bool ulist_position(ulist *list, int value, size_t *index) {
+  assert(list != NULL &&
+         "Failed to find position of element in unrolled list because list "
+         "pointer was NULL");
+  assert(index != NULL &&
+         "Failed to return position of element in unrolled list because index "
+         "pointer was NULL");
+
+  size_t position = 0;
+  for (node *ni = list->head; ni != NULL; ni = ni->next) {
+    for (uint32_t i = 0; i < ni->count; i++) {
+      if (ni->values[i] == value) {
+        *index = position + i;
+        return true;
+      }
+    }
+    position += ni->count;
+  }
+  return false;
+}
+
+bool ulist_empty(ulist *list) {
+  assert(list != NULL &&
+         "Failed to check if unrolled list is empty because pointer was NULL");
+  return list->length == 0;
+}
+
+void ulist_print(ulist *list) {
+  assert(list != NULL &&
+         "Failed to print unrolled list because pointer was NULL");
+
+  printf("[ ");
+  bool first = true;
+  for (node *ni = list->head; ni != NULL; ni = ni->next) {
+    for (uint32_t i = 0; i < ni->count; i++) {
+      printf(first ? "%d" : " <-> %d", ni->values[i]);
+      first = false;
+    }
+  }
+  printf(" ]\n");
+}
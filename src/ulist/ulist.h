@@ -0,0 +1,57 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef ULIST_H
+#define ULIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// An unrolled linked list. It has the same interface as llist, but each node
+// holds a block of values filling two cache lines instead of a single value,
+// which cuts the memory overhead per value and makes scans mostly sequential.
+// Nodes are split when they overflow and merged with a neighbour when they
+// become less than half full.
+typedef struct ulist ulist;
+
+ulist *ulist_create();
+ulist *ulist_create_from_values(int *values, size_t length);
+void ulist_destroy(ulist *list);
+size_t ulist_length(ulist *list);
+bool ulist_insert(ulist *list, size_t index, int value);
+int ulist_remove(ulist *list, size_t index);
+bool ulist_push_back(ulist *list, int value);
+int ulist_back(ulist *list);
+int ulist_pop_back(ulist *list);
+bool ulist_push_front(ulist *list, int value);
+int ulist_front(ulist *list);
+int ulist_pop_front(ulist *list);
+void ulist_set(ulist *list, size_t index, int value);
+int ulist_get(ulist *list, size_t index);
+void ulist_clear(ulist *list);
+bool ulist_contains(ulist *list, int value);
+bool ulist_equals(ulist *list1, ulist *list2);
+bool ulist_position(ulist *list, int value, size_t *index);
+bool ulist_empty(ulist *list);
+void ulist_print(ulist *list);
+
+#endif
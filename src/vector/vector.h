@@ -25,8 +25,15 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
-// A dynamic array.
+#include "../cpu/cpu.h"
+#include "vector_generic.h"
+
+// A dynamic array of ints. This is the vector_generic.h instantiation
+// VECTOR_DEFINE(vector, int); the declarations below are what
+// VECTOR_DECLARE(vector, int) would emit. See vector_inline.h for unchecked
+// inline access to the values.
 typedef struct vector vector;
 
 // Checks that a given vector capacity is not 0 and will not cause an unsigned
@@ -38,9 +45,38 @@ bool vector_capacity_ok(size_t capacity);
 // that it would cause an unsigned integer wrap to allocate space for this
 // vector. If unsure, call the vector_capacity_ok function first. When a vector
 // created using this function is no longer needed, it should be freed by
-// calling the vector_destroy function to avoid memory leaking.
+// calling the vector_destroy function to avoid memory leaking. If `capacity`
+// is at most VECTOR_SMALL_CAPACITY, the vector is made with a single
+// allocation and starts out with a capacity of VECTOR_SMALL_CAPACITY.
 vector *vector_create(size_t capacity);
 
+// Creates a new vector with given capacity whose values are stored in the
+// same allocation as the vector itself. Unlike vectors created using
+// vector_create, whose inline storage is limited to VECTOR_SMALL_CAPACITY
+// values, the inline storage of this vector has room for `capacity` values.
+// Once the vector outgrows it, its values move to a separate allocation, and
+// they move back if the vector later shrinks enough to fit again. The inline
+// storage is kept for the lifetime of the vector, so this is best suited for
+// vectors whose length rarely exceeds `capacity`. See vector_create for
+// everything else.
+vector *vector_create_inline(size_t capacity);
+
+// Creates a new vector with given capacity that grows and shrinks according
+// to a given policy. The policy is copied, so it need not outlive the vector.
+// `policy` must satisfy vector_policy_ok. See vector_create for everything
+// else.
+vector *vector_create_with_policy(size_t capacity,
+                                  const vector_policy *policy);
+
+// Creates a new vector with given capacity that gets the memory for itself
+// and its values from a given allocator instead of malloc. The allocator is
+// copied, but whatever its context points to must outlive the vector. When
+// the allocator is an arena, the vector may be dropped without calling
+// vector_destroy by resetting the arena. `allocator` must satisfy
+// allocator_ok. See vector_create for everything else.
+vector *vector_create_with_allocator(size_t capacity,
+                                     const allocator *allocator);
+
 // Destroys a given vector, freeing the allocated memory. Does nothing if
 // `vec` is NULL.
 void vector_destroy(vector *vec);
@@ -48,6 +84,32 @@ void vector_destroy(vector *vec);
 // Gets the length of a given vector. `vec` must not be NULL.
 size_t vector_length(vector *vec);
 
+// Gets the capacity of a given vector, i.e. how many values it can hold
+// before it has to grow. `vec` must not be NULL.
+size_t vector_capacity(vector *vec);
+
+// Gets the policy of a given vector. `vec` must not be NULL.
+vector_policy vector_get_policy(vector *vec);
+
+// Replaces the policy of a given vector. The new policy takes effect the next
+// time the vector grows or shrinks. `vec` must not be NULL and `policy` must
+// satisfy vector_policy_ok.
+void vector_set_policy(vector *vec, const vector_policy *policy);
+
+// Makes sure that a given vector can hold at least `capacity` values without
+// growing. Does nothing if the vector already has enough capacity. Returns
+// false if `capacity` would cause an unsigned integer wrap or an error occurs
+// during re-allocation. Note that unless automatic shrinking is disabled by
+// the policy of `vec`, removing values may shrink the vector below the
+// reserved capacity again. `vec` must not be NULL.
+bool vector_reserve(vector *vec, size_t capacity);
+
+// Shrinks the capacity of a given vector to its length, or to 1 if it is
+// empty. Vectors with inline storage never shrink below the capacity of that
+// storage, but will move their values back into it if they fit. Returns
+// false if an error occurs during re-allocation. `vec` must not be NULL.
+bool vector_shrink_to_fit(vector *vec);
+
 // Checks that a given vector is empty (holds no values). `vec` must not be
 // NULL.
 bool vector_empty(vector *vec);
@@ -81,6 +143,35 @@ bool vector_insert(vector *vec, size_t index, int value);
 // bounds.
 bool vector_remove(vector *vec, size_t index, int *value);
 
+// Inserts `count` values from a given array into a given vector at a given
+// index, preserving their order. The vector is grown at most once and the
+// values after `index` are moved only once, so this is much faster than
+// calling vector_insert in a loop. Returns false if the vector needs to grow
+// but the growing operation fails; the vector is left unchanged in that case.
+// `vec` must not be NULL, `values` must not be NULL unless `count` is 0 and
+// must not point into `vec`, and `index` must be within bounds.
+bool vector_insert_range(vector *vec, size_t index, const int *values,
+                         size_t count);
+
+// Removes `count` values starting at a given index in a given vector. If
+// `values` is not NULL, the removed values are copied into it, so it must
+// have room for `count` values. The vector is shrunk at most once. Returns
+// false if the operation tried to shrink the vector and failed because of an
+// error during re-allocation. Otherwise returns true. `vec` must not be NULL
+// and the range must be within bounds.
+bool vector_remove_range(vector *vec, size_t index, size_t count, int *values);
+
+// Pushes `count` values from a given array onto the end of a given vector. Is
+// functionally equivalent to
+// vector_insert_range(vec, vector_length(vec), values, count). See
+// vector_insert_range for failure conditions.
+bool vector_push_many(vector *vec, const int *values, size_t count);
+
+// Pushes all values of `other` onto the end of a given vector. `other` may be
+// the same vector as `vec`. See vector_insert_range for failure conditions.
+// Neither `vec` nor `other` may be NULL.
+bool vector_extend_from(vector *vec, vector *other);
+
 // Pushes a value onto the end of a given vector. Is functionally equivalent to
 // vector_insert(vec, vector_length(vec), value). See vector_insert for failure
 // conditions. `vec` must not be NULL.
@@ -95,6 +186,54 @@ int vector_peek(vector *vec);
 // failure conditions.
 bool vector_pop(vector *vec, int *value);
 
+// Finds the index of the first occurence of a given value in a given vector.
+// Returns true and puts the index into `index` if the value is found and
+// returns false otherwise. Like the other search functions below, this uses
+// SSE2 or AVX2 if the CPU supports it. `vec` and `index` must not be NULL.
+bool vector_find(vector *vec, int value, size_t *index);
+
+// Checks if a given vector contains a given value. `vec` must not be NULL.
+bool vector_contains(vector *vec, int value);
+
+// Counts the occurences of a given value in a given vector. `vec` must not be
+// NULL.
+size_t vector_count(vector *vec, int value);
+
+// Gets the sum of all values in a given vector. The sum is accumulated in 64
+// bits, so it does not overflow for vectors shorter than 2^32 values. `vec`
+// must not be NULL.
+int64_t vector_sum(vector *vec);
+
+// Gets the smallest value in a given vector. `vec` must not be NULL or empty.
+int vector_min(vector *vec);
+
+// Gets the largest value in a given vector. `vec` must not be NULL or empty.
+int vector_max(vector *vec);
+
+// Makes the search and aggregation functions above use the kernels of a
+// given CPU level from now on instead of the fastest ones the running CPU
+// supports. Meant for testing the kernels of every level. Returns false and
+// changes nothing if the running CPU does not support `level`.
+bool vector_force_kernels(cpu_level level);
+
+// Sorts a given vector in ascending order using an LSD radix sort. Returns
+// false if the scratch space needed by the sort could not be allocated, in
+// which case the vector is left unchanged. `vec` must not be NULL.
+bool vector_sort(vector *vec);
+
+// Sorts a given vector in ascending order using up to `nthreads` threads. The
+// vector is split into one chunk per thread, each chunk is radix sorted, and
+// the sorted chunks are merged pairwise in parallel. Vectors too small to
+// benefit from more threads are sorted with fewer. Returns false if the
+// scratch space needed by the sort could not be allocated, in which case the
+// vector is left unchanged. `vec` must not be NULL and `nthreads` must not be
+// 0.
+bool vector_sort_parallel(vector *vec, size_t nthreads);
+
+// Checks if a given vector is sorted in ascending order. `vec` must not be
+// NULL.
+bool vector_is_sorted(vector *vec);
+
 // Prints a string representation of a given vector. `vec` must not be NULL.
 void vector_print(vector *vec);
 
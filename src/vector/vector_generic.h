@@ -0,0 +1,631 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef VECTOR_GENERIC_H
+#define VECTOR_GENERIC_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../allocator/allocator.h"
+
+// Generator for dynamic arrays of any element type.
+//
+// VECTOR_DECLARE(name, T) declares an opaque type `name` holding values of
+// type `T` together with functions `name_create`, `name_push`, `name_get`
+// and so on. They behave exactly like their counterparts in vector.h, which
+// documents them, except that `int` is replaced by `T`. VECTOR_DEFINE(name,
+// T) defines the type and its functions and should be used in exactly one
+// source file. For example:
+//
+//   // point_vector.h
+//   typedef struct point { double x, y; } point;
+//   VECTOR_DECLARE(point_vector, point)
+//
+//   // point_vector.c
+//   VECTOR_DEFINE(point_vector, point)
+//
+// Alternatively, VECTOR_DEFINE_INLINE(name, T) declares and defines
+// everything as static inline functions in one go, which lets the compiler
+// inline and specialize them at every call site at the cost of exposing the
+// layout of `name`. It also defines the unchecked accessors of
+// VECTOR_DEFINE_ACCESSORS. The `int` vector of vector.h is itself an
+// instantiation of this generator. Values are moved around using
+// memcpy/memmove, so `T` must be trivially copyable.
+
+// Vectors created with a capacity of at most this many values keep their
+// values inline in the vector itself until they outgrow it, so that small
+// vectors only need a single allocation.
+#define VECTOR_SMALL_CAPACITY 8
+
+// Controls when and by how much a vector changes its capacity.
+typedef struct vector_policy {
+  // How much to scale vector capacity by when growing. Vectors shrink by the
+  // inverse of this factor. Must be greater than 1.
+  double growth_factor;
+
+  // Threshold at which to shrink a vector. A vector will be shrunk if its
+  // length is less than or equal to `shrink_threshold` * vector capacity AND
+  // the shrunken capacity is greater than or equal to `min_shrink_capacity`.
+  // Must be less than 1 / `growth_factor`, so that a vector that has just
+  // grown never qualifies for shrinking and a vector that has just shrunk is
+  // never full. This gap is what stops a vector whose length moves back and
+  // forth around a resize boundary from re-allocating on every change.
+  double shrink_threshold;
+
+  // The minimum capacity that a vector is able to be automatically shrunk to.
+  // Must not be 0.
+  size_t min_shrink_capacity;
+
+  // Whether removing values may shrink a vector. If false, a vector only ever
+  // shrinks when vector_shrink_to_fit is called.
+  bool auto_shrink;
+} vector_policy;
+
+// Gets the policy used by vectors that are not given one explicitly. A vector
+// using this policy doubles its capacity when it grows and halves it when its
+// length drops to 30% of its capacity, but never shrinks below a capacity of 4.
+static inline vector_policy vector_default_policy() {
+  vector_policy policy = {
+      .growth_factor = 2.0,
+      .shrink_threshold = 0.3,
+      .min_shrink_capacity = 4,
+      .auto_shrink = true,
+  };
+  return policy;
+}
+
+// Checks that a given policy is not NULL and satisfies the constraints listed
+// on the fields of vector_policy.
+static inline bool vector_policy_ok(const vector_policy *policy) {
+  return policy != NULL && policy->growth_factor > 1.0 &&
+         policy->shrink_threshold >= 0.0 &&
+         policy->shrink_threshold < 1.0 / policy->growth_factor &&
+         policy->min_shrink_capacity > 0;
+}
+
+// Scales a given capacity by a given factor. Returns SIZE_MAX if the scaled
+// capacity cannot be represented, which no capacity check accepts.
+static inline size_t vector_scale(size_t capacity, double factor) {
+  double scaled = capacity * factor;
+  if (scaled >= (double)SIZE_MAX) {
+    return SIZE_MAX;
+  }
+  return scaled;
+}
+
+// Declares a vector type `name` of `T` and its functions, giving every
+// function the storage class `scope`, which is either empty or `static inline`.
+#define VECTOR_DECLARE_(name, T, scope)                                        \
+  typedef struct name name;                                                    \
+  scope bool name##_capacity_ok(size_t capacity);                              \
+  scope name *name##_create(size_t capacity);                                  \
+  scope name *name##_create_with_policy(size_t capacity,                       \
+                                        const vector_policy *policy);          \
+  scope name *name##_create_inline(size_t capacity);                           \
+  scope name *name##_create_with_allocator(size_t capacity,                    \
+                                           const allocator *allocator);        \
+  scope void name##_destroy(name *vec);                                        \
+  scope size_t name##_length(name *vec);                                       \
+  scope size_t name##_capacity(name *vec);                                     \
+  scope vector_policy name##_get_policy(name *vec);                            \
+  scope void name##_set_policy(name *vec, const vector_policy *policy);        \
+  scope bool name##_reserve(name *vec, size_t capacity);                       \
+  scope bool name##_shrink_to_fit(name *vec);                                  \
+  scope bool name##_empty(name *vec);                                          \
+  scope bool name##_full(name *vec);                                           \
+  scope T name##_get(name *vec, size_t index);                                 \
+  scope void name##_set(name *vec, size_t index, T value);                     \
+  scope bool name##_insert(name *vec, size_t index, T value);                  \
+  scope bool name##_remove(name *vec, size_t index, T *value);                 \
+  scope bool name##_insert_range(name *vec, size_t index, const T *values,     \
+                                 size_t count);                                \
+  scope bool name##_remove_range(name *vec, size_t index, size_t count,        \
+                                 T *values);                                   \
+  scope bool name##_push_many(name *vec, const T *values, size_t count);       \
+  scope bool name##_extend_from(name *vec, name *other);                       \
+  scope bool name##_push(name *vec, T value);                                  \
+  scope T name##_peek(name *vec);                                              \
+  scope bool name##_pop(name *vec, T *value);
+
+// Declares a vector type `name` of `T` and its functions.
+#define VECTOR_DECLARE(name, T) VECTOR_DECLARE_(name, T, )
+
+// Defines the layout of a vector type `name` of `T` previously declared with
+// VECTOR_DECLARE.
+#define VECTOR_DEFINE_STRUCT(name, T)                                          \
+  struct name {                                                                \
+    T *values;                                                                 \
+    size_t length;                                                             \
+    size_t capacity;                                                           \
+    vector_policy policy;                                                      \
+    /* Where the vector and its values are allocated from */                   \
+    allocator allocator;                                                       \
+    /* Number of slots in `inline_values`. `values` points to                  \
+       `inline_values` for as long as the vector fits in them and to a         \
+       separate heap allocation otherwise. */                                  \
+    size_t inline_capacity;                                                    \
+    T inline_values[];                                                         \
+  };
+
+// Defines static inline accessors for a vector type `name` of `T` whose layout
+// has been defined with VECTOR_DEFINE_STRUCT. None of them check their
+// arguments, so they compile down to plain pointer arithmetic. `name_data` and
+// `name_begin` return a pointer to the first value, `name_end` a pointer one
+// past the last value, and `name_length_unchecked`, `name_get_unchecked` and
+// `name_set_unchecked` mirror their checked counterparts. The pointers are
+// invalidated by anything that may change the capacity of the vector.
+#define VECTOR_DEFINE_ACCESSORS(name, T)                                       \
+  static inline T *name##_data(name *vec) { return vec->values; }              \
+  static inline T *name##_begin(name *vec) { return vec->values; }             \
+  static inline T *name##_end(name *vec) { return vec->values + vec->length; } \
+  static inline size_t name##_length_unchecked(name *vec) {                    \
+    return vec->length;                                                        \
+  }                                                                            \
+  static inline T name##_get_unchecked(name *vec, size_t index) {              \
+    return vec->values[index];                                                 \
+  }                                                                            \
+  static inline void name##_set_unchecked(name *vec, size_t index, T value) {  \
+    vec->values[index] = value;                                                \
+  }
+
+// Defines the functions of a vector type `name` of `T` whose layout has been
+// defined with VECTOR_DEFINE_STRUCT. Every function is given the storage class
+// `scope`, which is either empty or `static inline`. Helpers are always
+// `static inline` and prefixed with `name_impl_`.
+#define VECTOR_DEFINE_FUNCTIONS_(name, T, scope)                               \
+  static inline bool name##_impl_is_inline(name *vec) {                        \
+    return vec->values == vec->inline_values;                                  \
+  }                                                                            \
+                                                                               \
+  static inline size_t name##_impl_grown_capacity(name *vec,                   \
+                                                  size_t capacity) {           \
+    size_t new_capacity = vector_scale(capacity, vec->policy.growth_factor);   \
+    return new_capacity > capacity ? new_capacity : capacity + 1;              \
+  }                                                                            \
+                                                                               \
+  static inline size_t name##_impl_shrunken_capacity(name *vec,                \
+                                                     size_t capacity) {        \
+    return vector_scale(capacity, 1.0 / vec->policy.growth_factor);            \
+  }                                                                            \
+                                                                               \
+  /* Vectors with inline slots move their values back into them as soon as     \
+     `new_capacity` fits, and out of them into the heap once it does not. */   \
+  static inline bool name##_impl_resize(name *vec, size_t new_capacity) {      \
+    if (!name##_capacity_ok(new_capacity)) {                                   \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    if (new_capacity <= vec->inline_capacity) {                                \
+      if (!name##_impl_is_inline(vec)) {                                       \
+        memcpy(vec->inline_values, vec->values, vec->length * sizeof(T));      \
+        allocator_deallocate(&vec->allocator, vec->values,                     \
+                             vec->capacity * sizeof(T));                       \
+        vec->values = vec->inline_values;                                      \
+        vec->capacity = vec->inline_capacity;                                  \
+      }                                                                        \
+      return true;                                                             \
+    }                                                                          \
+                                                                               \
+    T *new_values;                                                             \
+    if (name##_impl_is_inline(vec)) {                                          \
+      new_values =                                                             \
+          allocator_allocate(&vec->allocator, new_capacity * sizeof(T));       \
+      if (new_values != NULL) {                                                \
+        memcpy(new_values, vec->values, vec->length * sizeof(T));              \
+      }                                                                        \
+    } else {                                                                   \
+      new_values = allocator_reallocate(&vec->allocator, vec->values,          \
+                                        vec->capacity * sizeof(T),             \
+                                        new_capacity * sizeof(T));             \
+    }                                                                          \
+    if (new_values == NULL) {                                                  \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    vec->capacity = new_capacity;                                              \
+    vec->values = new_values;                                                  \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  static inline bool name##_impl_grow(name *vec) {                             \
+    return name##_impl_resize(vec,                                             \
+                              name##_impl_grown_capacity(vec, vec->capacity)); \
+  }                                                                            \
+                                                                               \
+  static inline bool name##_impl_shrink(name *vec) {                           \
+    return name##_impl_resize(                                                 \
+        vec, name##_impl_shrunken_capacity(vec, vec->capacity));               \
+  }                                                                            \
+                                                                               \
+  /* Grows to the capacity that pushing values one at a time would reach,      \
+     but with a single re-allocation. */                                       \
+  static inline bool name##_impl_grow_to_fit(name *vec, size_t length) {       \
+    if (length <= vec->capacity) {                                             \
+      return true;                                                             \
+    }                                                                          \
+    if (!name##_capacity_ok(length)) {                                         \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    size_t new_capacity = vec->capacity;                                       \
+    while (new_capacity < length) {                                            \
+      size_t grown = name##_impl_grown_capacity(vec, new_capacity);            \
+      if (!name##_capacity_ok(grown)) {                                        \
+        /* Growing further would wrap, so settle for what is needed */         \
+        new_capacity = length;                                                 \
+        break;                                                                 \
+      }                                                                        \
+      new_capacity = grown;                                                    \
+    }                                                                          \
+    return name##_impl_resize(vec, new_capacity);                              \
+  }                                                                            \
+                                                                               \
+  static inline bool name##_impl_should_shrink(name *vec, size_t capacity) {   \
+    size_t threshold = vector_scale(capacity, vec->policy.shrink_threshold);   \
+    return vec->policy.auto_shrink && capacity > vec->inline_capacity &&       \
+           vec->length <= threshold &&                                         \
+           name##_impl_shrunken_capacity(vec, capacity) >=                     \
+               vec->policy.min_shrink_capacity;                                \
+  }                                                                            \
+                                                                               \
+  /* Shrinks for as long as there is excess capacity, using a single           \
+     re-allocation. */                                                         \
+  static inline bool name##_impl_shrink_to_threshold(name *vec) {              \
+    size_t new_capacity = vec->capacity;                                       \
+    while (name##_impl_should_shrink(vec, new_capacity)) {                     \
+      new_capacity = name##_impl_shrunken_capacity(vec, new_capacity);         \
+    }                                                                          \
+    return new_capacity == vec->capacity ||                                    \
+           name##_impl_resize(vec, new_capacity);                              \
+  }                                                                            \
+                                                                               \
+  static inline name *name##_impl_create(size_t capacity,                      \
+                                         size_t inline_capacity,               \
+                                         const vector_policy *policy,          \
+                                         const allocator *allocator) {         \
+    assert(name##_capacity_ok(capacity) &&                                     \
+           "Failed to create " #name " because capacity was 0 or would cause " \
+           "an unsigned integer wrap");                                        \
+    assert(vector_policy_ok(policy) &&                                         \
+           "Failed to create " #name " because policy was NULL or invalid");   \
+    assert(allocator_ok(allocator) &&                                          \
+           "Failed to create " #name " because allocator was NULL or "         \
+           "invalid");                                                         \
+                                                                               \
+    if (inline_capacity > (SIZE_MAX - sizeof(name)) / sizeof(T)) {             \
+      return NULL;                                                             \
+    }                                                                          \
+    size_t size = sizeof(name) + inline_capacity * sizeof(T);                  \
+    name *vec = allocator_allocate(allocator, size);                           \
+    if (vec == NULL) {                                                         \
+      return NULL;                                                             \
+    }                                                                          \
+                                                                               \
+    vec->inline_capacity = inline_capacity;                                    \
+    if (capacity <= inline_capacity) {                                         \
+      vec->values = vec->inline_values;                                        \
+      vec->capacity = inline_capacity;                                         \
+    } else {                                                                   \
+      vec->values = allocator_allocate(allocator, capacity * sizeof(T));       \
+      if (vec->values == NULL) {                                               \
+        allocator_deallocate(allocator, vec, size);                            \
+        return NULL;                                                           \
+      }                                                                        \
+      vec->capacity = capacity;                                                \
+    }                                                                          \
+                                                                               \
+    vec->length = 0;                                                           \
+    vec->policy = *policy;                                                     \
+    vec->allocator = *allocator;                                               \
+    return vec;                                                                \
+  }                                                                            \
+                                                                               \
+  scope bool name##_capacity_ok(size_t capacity) {                             \
+    return capacity > 0 && capacity <= SIZE_MAX / sizeof(T);                   \
+  }                                                                            \
+                                                                               \
+  scope name *name##_create(size_t capacity) {                                 \
+    vector_policy policy = vector_default_policy();                            \
+    return name##_create_with_policy(capacity, &policy);                       \
+  }                                                                            \
+                                                                               \
+  scope name *name##_create_with_policy(size_t capacity,                       \
+                                        const vector_policy *policy) {         \
+    size_t inline_capacity =                                                   \
+        capacity <= VECTOR_SMALL_CAPACITY ? VECTOR_SMALL_CAPACITY : 0;         \
+    allocator allocator = allocator_default();                                 \
+    return name##_impl_create(capacity, inline_capacity, policy, &allocator);  \
+  }                                                                            \
+                                                                               \
+  scope name *name##_create_inline(size_t capacity) {                          \
+    vector_policy policy = vector_default_policy();                            \
+    allocator allocator = allocator_default();                                 \
+    return name##_impl_create(capacity, capacity, &policy, &allocator);        \
+  }                                                                            \
+                                                                               \
+  scope name *name##_create_with_allocator(size_t capacity,                    \
+                                           const allocator *allocator) {       \
+    size_t inline_capacity =                                                   \
+        capacity <= VECTOR_SMALL_CAPACITY ? VECTOR_SMALL_CAPACITY : 0;         \
+    vector_policy policy = vector_default_policy();                            \
+    return name##_impl_create(capacity, inline_capacity, &policy, allocator);  \
+  }                                                                            \
+                                                                               \
+  scope void name##_destroy(name *vec) {                                       \
+    if (vec != NULL) {                                                         \
+      if (!name##_impl_is_inline(vec)) {                                       \
+        allocator_deallocate(&vec->allocator, vec->values,                     \
+                             vec->capacity * sizeof(T));                       \
+      }                                                                        \
+      /* Copied out first, since it lives in the vector being freed */         \
+      allocator allocator = vec->allocator;                                    \
+      allocator_deallocate(&allocator, vec,                                    \
+                           sizeof(name) + vec->inline_capacity * sizeof(T));   \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  scope size_t name##_length(name *vec) {                                      \
+    assert(vec != NULL &&                                                      \
+           "Failed to get " #name " length because pointer was NULL");         \
+    return vec->length;                                                        \
+  }                                                                            \
+                                                                               \
+  scope size_t name##_capacity(name *vec) {                                    \
+    assert(vec != NULL &&                                                      \
+           "Failed to get " #name " capacity because pointer was NULL");       \
+    return vec->capacity;                                                      \
+  }                                                                            \
+                                                                               \
+  scope vector_policy name##_get_policy(name *vec) {                           \
+    assert(vec != NULL &&                                                      \
+           "Failed to get " #name " policy because pointer was NULL");         \
+    return vec->policy;                                                        \
+  }                                                                            \
+                                                                               \
+  scope void name##_set_policy(name *vec, const vector_policy *policy) {       \
+    assert(vec != NULL &&                                                      \
+           "Failed to set " #name " policy because pointer was NULL");         \
+    assert(vector_policy_ok(policy) &&                                         \
+           "Failed to set " #name " policy because policy was NULL or "        \
+           "invalid");                                                         \
+    vec->policy = *policy;                                                     \
+  }                                                                            \
+                                                                               \
+  scope bool name##_reserve(name *vec, size_t capacity) {                      \
+    assert(vec != NULL &&                                                      \
+           "Failed to reserve capacity in " #name                             \
+           " because pointer was NULL");                                       \
+    return capacity <= vec->capacity || name##_impl_resize(vec, capacity);     \
+  }                                                                            \
+                                                                               \
+  scope bool name##_shrink_to_fit(name *vec) {                                 \
+    assert(vec != NULL &&                                                      \
+           "Failed to shrink " #name " to fit because pointer was NULL");      \
+    size_t capacity = vec->length > 0 ? vec->length : 1;                       \
+    return capacity == vec->capacity || name##_impl_resize(vec, capacity);     \
+  }                                                                            \
+                                                                               \
+  scope bool name##_empty(name *vec) {                                         \
+    assert(vec != NULL &&                                                      \
+           "Failed to check if " #name " was empty because pointer was NULL"); \
+    return vec->length == 0;                                                   \
+  }                                                                            \
+                                                                               \
+  scope bool name##_full(name *vec) {                                          \
+    assert(vec != NULL &&                                                      \
+           "Failed to check if " #name " was full because pointer was NULL");  \
+    return vec->length == vec->capacity;                                       \
+  }                                                                            \
+                                                                               \
+  scope T name##_get(name *vec, size_t index) {                                \
+    assert(vec != NULL &&                                                      \
+           "Failed to get value from " #name " because pointer was NULL");     \
+    assert(!name##_empty(vec) &&                                               \
+           "Failed to get element from " #name " because it was empty");       \
+    assert(index < vec->length &&                                              \
+           "Failed to get element from " #name " because index was out of "    \
+           "bounds");                                                          \
+    return *(vec->values + index);                                             \
+  }                                                                            \
+                                                                               \
+  scope void name##_set(name *vec, size_t index, T value) {                    \
+    assert(vec != NULL &&                                                      \
+           "Failed to set value in " #name " because pointer was NULL");       \
+    assert(!name##_empty(vec) &&                                               \
+           "Failed to set value in " #name " because it was empty");           \
+    assert(index < vec->length &&                                              \
+           "Failed to set element in " #name " because index was out of "      \
+           "bounds");                                                          \
+    *(vec->values + index) = value;                                            \
+  }                                                                            \
+                                                                               \
+  scope bool name##_insert(name *vec, size_t index, T value) {                 \
+    assert(vec != NULL &&                                                      \
+           "Failed to insert value into " #name " because pointer was NULL");  \
+    assert(index <= vec->length &&                                             \
+           "Failed to insert value into " #name " because index was out of "   \
+           "bounds");                                                          \
+                                                                               \
+    /* Grow array if necessary */                                              \
+    if (name##_full(vec) && !name##_impl_grow(vec)) {                          \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    /* Move elements forward if necessary */                                   \
+    if (index < vec->length) {                                                 \
+      T *src = vec->values + index;                                            \
+      T *dst = src + 1;                                                        \
+      size_t num = vec->length - index;                                        \
+      memmove(dst, src, num * sizeof(T));                                      \
+    }                                                                          \
+    vec->length++;                                                             \
+    *(vec->values + index) = value;                                            \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  scope bool name##_remove(name *vec, size_t index, T *value) {                \
+    assert(vec != NULL &&                                                      \
+           "Failed to remove value from " #name " because pointer was NULL");  \
+                                                                               \
+    *value = name##_get(vec, index);                                           \
+                                                                               \
+    /* Move elements backwards if necessary */                                 \
+    if (index < vec->length - 1) {                                             \
+      T *dst = vec->values + index;                                            \
+      T *src = dst + 1;                                                        \
+      size_t num = vec->length - 1 - index;                                    \
+      memmove(dst, src, num * sizeof(T));                                      \
+    }                                                                          \
+    vec->length--;                                                             \
+                                                                               \
+    /* Shrink if there is a excess capacity */                                 \
+    return !name##_impl_should_shrink(vec, vec->capacity) ||                   \
+           name##_impl_shrink(vec);                                            \
+  }                                                                            \
+                                                                               \
+  scope bool name##_insert_range(name *vec, size_t index, const T *values,     \
+                                 size_t count) {                               \
+    assert(vec != NULL && "Failed to insert values into " #name                \
+                          " because vector pointer was NULL");                 \
+    assert((values != NULL || count == 0) &&                                   \
+           "Failed to insert values into " #name                               \
+           " because value array pointer was NULL");                           \
+    assert(index <= vec->length &&                                             \
+           "Failed to insert values into " #name " because index was out of "  \
+           "bounds");                                                          \
+                                                                               \
+    if (count == 0) {                                                          \
+      return true;                                                             \
+    }                                                                          \
+    if (count > SIZE_MAX - vec->length ||                                      \
+        !name##_impl_grow_to_fit(vec, vec->length + count)) {                  \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    /* Move the tail forward once to make room for all of the new values */    \
+    size_t num = vec->length - index;                                          \
+    if (num > 0) {                                                             \
+      memmove(vec->values + index + count, vec->values + index,                \
+              num * sizeof(T));                                                \
+    }                                                                          \
+    memcpy(vec->values + index, values, count * sizeof(T));                    \
+    vec->length += count;                                                      \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  scope bool name##_remove_range(name *vec, size_t index, size_t count,        \
+                                 T *values) {                                  \
+    assert(vec != NULL &&                                                      \
+           "Failed to remove values from " #name " because pointer was NULL"); \
+    assert(index <= vec->length && count <= vec->length - index &&             \
+           "Failed to remove values from " #name " because range was out of "  \
+           "bounds");                                                          \
+                                                                               \
+    if (count == 0) {                                                          \
+      return true;                                                             \
+    }                                                                          \
+    if (values != NULL) {                                                      \
+      memcpy(values, vec->values + index, count * sizeof(T));                  \
+    }                                                                          \
+                                                                               \
+    /* Move the tail backwards once to close the gap */                        \
+    size_t num = vec->length - index - count;                                  \
+    if (num > 0) {                                                             \
+      memmove(vec->values + index, vec->values + index + count,                \
+              num * sizeof(T));                                                \
+    }                                                                          \
+    vec->length -= count;                                                      \
+                                                                               \
+    /* Shrink if there is a excess capacity */                                 \
+    return name##_impl_shrink_to_threshold(vec);                               \
+  }                                                                            \
+                                                                               \
+  scope bool name##_push_many(name *vec, const T *values, size_t count) {      \
+    assert(vec != NULL &&                                                      \
+           "Failed to push values onto " #name " because pointer was NULL");   \
+    return name##_insert_range(vec, vec->length, values, count);               \
+  }                                                                            \
+                                                                               \
+  scope bool name##_extend_from(name *vec, name *other) {                      \
+    assert(vec != NULL && other != NULL &&                                     \
+           "Failed to extend " #name " because at least one of the pointers "  \
+           "was NULL");                                                        \
+                                                                               \
+    size_t count = other->length;                                              \
+    if (count == 0) {                                                          \
+      return true;                                                             \
+    }                                                                          \
+    if (count > SIZE_MAX - vec->length ||                                      \
+        !name##_impl_grow_to_fit(vec, vec->length + count)) {                  \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    /* Read from `other` only after growing, since it may be `vec` itself */   \
+    memcpy(vec->values + vec->length, other->values, count * sizeof(T));       \
+    vec->length += count;                                                      \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  scope bool name##_push(name *vec, T value) {                                 \
+    assert(vec != NULL &&                                                      \
+           "Failed to push value onto " #name " because pointer was NULL");    \
+    return name##_insert(vec, vec->length, value);                             \
+  }                                                                            \
+                                                                               \
+  scope T name##_peek(name *vec) {                                             \
+    assert(vec != NULL &&                                                      \
+           "Failed to peek value from " #name " because pointer was NULL");    \
+    return name##_get(vec, vec->length - 1);                                   \
+  }                                                                            \
+                                                                               \
+  scope bool name##_pop(name *vec, T *value) {                                 \
+    assert(vec != NULL && "Failed to pop value from " #name                    \
+                          " because vector pointer was NULL");                 \
+    assert(value != NULL && "Failed to pop value from " #name                  \
+                            " because value pointer was NULL");                \
+    return name##_remove(vec, vec->length - 1, value);                         \
+  }
+
+// Defines the functions of a vector type `name` of `T` previously declared
+// with VECTOR_DECLARE whose layout has been defined with VECTOR_DEFINE_STRUCT.
+#define VECTOR_DEFINE_FUNCTIONS(name, T) VECTOR_DEFINE_FUNCTIONS_(name, T, )
+
+// Defines a vector type `name` of `T` previously declared with VECTOR_DECLARE
+// and its functions.
+#define VECTOR_DEFINE(name, T)                                                 \
+  VECTOR_DEFINE_STRUCT(name, T)                                                \
+  VECTOR_DEFINE_FUNCTIONS(name, T)
+
+// Declares and defines a vector type `name` of `T` whose functions are all
+// static inline.
+#define VECTOR_DEFINE_INLINE(name, T)                                          \
+  VECTOR_DECLARE_(name, T, static inline)                                      \
+  VECTOR_DEFINE_STRUCT(name, T)                                                \
+  VECTOR_DEFINE_ACCESSORS(name, T)                                             \
+  VECTOR_DEFINE_FUNCTIONS_(name, T, static inline)
+
+#endif
@@ -0,0 +1,51 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef VECTOR_INLINE_H
+#define VECTOR_INLINE_H
+
+#include "vector.h"
+
+// Opt-in fast path for vector. Including this header exposes the layout of
+// vector and defines the following static inline functions, none of which
+// check their arguments:
+//
+//   int *vector_data(vector *vec);
+//   int *vector_begin(vector *vec);
+//   int *vector_end(vector *vec);
+//   size_t vector_length_unchecked(vector *vec);
+//   int vector_get_unchecked(vector *vec, size_t index);
+//   void vector_set_unchecked(vector *vec, size_t index, int value);
+//
+// vector_data and vector_begin both return a pointer to the first value and
+// vector_end returns a pointer one past the last value, so a vector can be
+// walked like a plain array:
+//
+//   for (int *it = vector_begin(vec); it != vector_end(vec); it++) { ... }
+//
+// The pointers are invalidated by any call that may change the capacity of the
+// vector, such as vector_push or vector_remove. Indices passed to the
+// unchecked accessors must be within bounds.
+VECTOR_DEFINE_STRUCT(vector, int)
+VECTOR_DEFINE_ACCESSORS(vector, int)
+
+#endif
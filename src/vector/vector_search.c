@@ -0,0 +1,417 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "vector.h"
+#include "vector_inline.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "../cpu/cpu.h"
+
+// Search and aggregation kernels for vector. Every operation has a portable
+// scalar kernel and, on x86 compilers that support it, SSE2 and AVX2 kernels.
+// The fastest kernel supported by the running CPU is picked at runtime, so
+// the library can be built without any -m flags and still use AVX2 where it
+// is available.
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// Number of elements processed per lane of 32-bit counters before they are
+// flushed into a size_t, which keeps the counters from wrapping.
+#define COUNT_FLUSH_INTERVAL ((size_t)1 << 20)
+
+// A set of kernels. Each kernel takes a pointer to `length` values, where
+// `length` may be 0 for every kernel except min and max.
+typedef struct kernels {
+  // Gets the index of the first occurence of `value`, or `length` if there is
+  // none.
+  size_t (*find)(const int *values, size_t length, int value);
+  size_t (*count)(const int *values, size_t length, int value);
+  int64_t (*sum)(const int *values, size_t length);
+  int (*min)(const int *values, size_t length);
+  int (*max)(const int *values, size_t length);
+} kernels;
+
+static size_t find_scalar(const int *values, size_t length, int value) {
+  for (size_t i = 0; i < length; i++) {
+    if (values[i] == value) {
+      return i;
+    }
+  }
+  return length;
+}
+
+static size_t count_scalar(const int *values, size_t length, int value) {
+  size_t count = 0;
+  for (size_t i = 0; i < length; i++) {
+    count += values[i] == value;
+  }
+  return count;
+}
+
+static int64_t sum_scalar(const int *values, size_t length) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < length; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+static int min_scalar(const int *values, size_t length) {
+  int min = values[0];
+  for (size_t i = 1; i < length; i++) {
+    min = values[i] < min ? values[i] : min;
+  }
+  return min;
+}
+
+static int max_scalar(const int *values, size_t length) {
+  int max = values[0];
+  for (size_t i = 1; i < length; i++) {
+    max = values[i] > max ? values[i] : max;
+  }
+  return max;
+}
+
+static const kernels SCALAR_KERNELS = {
+    .find = find_scalar,
+    .count = count_scalar,
+    .sum = sum_scalar,
+    .min = min_scalar,
+    .max = max_scalar,
+};
+
+#ifdef CPU_X86
+
+__attribute__((target("sse2"))) static size_t
+find_sse2(const int *values, size_t length, int value) {
+  __m128i needle = _mm_set1_epi32(value);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i eq0 = _mm_cmpeq_epi32(
+        _mm_loadu_si128((const __m128i *)(values + i)), needle);
+    __m128i eq1 = _mm_cmpeq_epi32(
+        _mm_loadu_si128((const __m128i *)(values + i + 4)), needle);
+    __m128i eq2 = _mm_cmpeq_epi32(
+        _mm_loadu_si128((const __m128i *)(values + i + 8)), needle);
+    __m128i eq3 = _mm_cmpeq_epi32(
+        _mm_loadu_si128((const __m128i *)(values + i + 12)), needle);
+    __m128i any = _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+    if (_mm_movemask_epi8(any) != 0) {
+      // Found somewhere in this block, so let the scalar loop pinpoint it
+      break;
+    }
+  }
+  return i + find_scalar(values + i, length - i, value);
+}
+
+__attribute__((target("sse2"))) static size_t
+count_sse2(const int *values, size_t length, int value) {
+  __m128i needle = _mm_set1_epi32(value);
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 4 <= length) {
+    // Matches are -1, so subtracting them counts up
+    __m128i counts = _mm_setzero_si128();
+    size_t end = length - (length - i) % 4;
+    if (end - i > 4 * COUNT_FLUSH_INTERVAL) {
+      end = i + 4 * COUNT_FLUSH_INTERVAL;
+    }
+    for (; i < end; i += 4) {
+      __m128i eq = _mm_cmpeq_epi32(
+          _mm_loadu_si128((const __m128i *)(values + i)), needle);
+      counts = _mm_sub_epi32(counts, eq);
+    }
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, counts);
+    count += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+  return count + count_scalar(values + i, length - i, value);
+}
+
+__attribute__((target("sse2"))) static int64_t sum_sse2(const int *values,
+                                                          size_t length) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(values + i));
+    // Sign extend to 64 bits by interleaving with the sign mask
+    __m128i sign = _mm_cmpgt_epi32(zero, v);
+    sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(v, sign));
+    sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(v, sign));
+  }
+  int64_t lanes[2];
+  _mm_storeu_si128((__m128i *)lanes, sum);
+  return lanes[0] + lanes[1] + sum_scalar(values + i, length - i);
+}
+
+// SSE2 has no 32-bit min/max, so they are done with a compare and select.
+__attribute__((target("sse2"))) static __m128i min_epi32_sse2(__m128i a,
+                                                                __m128i b) {
+  __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, b),
+                      _mm_andnot_si128(a_greater, a));
+}
+
+__attribute__((target("sse2"))) static __m128i max_epi32_sse2(__m128i a,
+                                                                __m128i b) {
+  __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, a),
+                      _mm_andnot_si128(a_greater, b));
+}
+
+__attribute__((target("sse2"))) static int min_sse2(const int *values,
+                                                    size_t length) {
+  if (length < 4) {
+    return min_scalar(values, length);
+  }
+  __m128i min = _mm_loadu_si128((const __m128i *)values);
+  size_t i = 4;
+  for (; i + 4 <= length; i += 4) {
+    min = min_epi32_sse2(min, _mm_loadu_si128((const __m128i *)(values + i)));
+  }
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, min);
+  int result = min_scalar(lanes, 4);
+  if (i < length) {
+    int tail = min_scalar(values + i, length - i);
+    result = tail < result ? tail : result;
+  }
+  return result;
+}
+
+__attribute__((target("sse2"))) static int max_sse2(const int *values,
+                                                    size_t length) {
+  if (length < 4) {
+    return max_scalar(values, length);
+  }
+  __m128i max = _mm_loadu_si128((const __m128i *)values);
+  size_t i = 4;
+  for (; i + 4 <= length; i += 4) {
+    max = max_epi32_sse2(max, _mm_loadu_si128((const __m128i *)(values + i)));
+  }
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, max);
+  int result = max_scalar(lanes, 4);
+  if (i < length) {
+    int tail = max_scalar(values + i, length - i);
+    result = tail > result ? tail : result;
+  }
+  return result;
+}
+
+static const kernels SSE2_KERNELS = {
+    .find = find_sse2,
+    .count = count_sse2,
+    .sum = sum_sse2,
+    .min = min_sse2,
+    .max = max_sse2,
+};
+
+__attribute__((target("avx2"))) static size_t
+find_avx2(const int *values, size_t length, int value) {
+  __m256i needle = _mm256_set1_epi32(value);
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i eq0 = _mm256_cmpeq_epi32(
+        _mm256_loadu_si256((const __m256i *)(values + i)), needle);
+    __m256i eq1 = _mm256_cmpeq_epi32(
+        _mm256_loadu_si256((const __m256i *)(values + i + 8)), needle);
+    __m256i eq2 = _mm256_cmpeq_epi32(
+        _mm256_loadu_si256((const __m256i *)(values + i + 16)), needle);
+    __m256i eq3 = _mm256_cmpeq_epi32(
+        _mm256_loadu_si256((const __m256i *)(values + i + 24)), needle);
+    __m256i any =
+        _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+    if (!_mm256_testz_si256(any, any)) {
+      // Found somewhere in this block, so let the scalar loop pinpoint it
+      break;
+    }
+  }
+  return i + find_scalar(values + i, length - i, value);
+}
+
+__attribute__((target("avx2"))) static size_t
+count_avx2(const int *values, size_t length, int value) {
+  __m256i needle = _mm256_set1_epi32(value);
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 8 <= length) {
+    // Matches are -1, so subtracting them counts up
+    __m256i counts = _mm256_setzero_si256();
+    size_t end = length - (length - i) % 8;
+    if (end - i > 8 * COUNT_FLUSH_INTERVAL) {
+      end = i + 8 * COUNT_FLUSH_INTERVAL;
+    }
+    for (; i < end; i += 8) {
+      __m256i eq = _mm256_cmpeq_epi32(
+          _mm256_loadu_si256((const __m256i *)(values + i)), needle);
+      counts = _mm256_sub_epi32(counts, eq);
+    }
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, counts);
+    for (int lane = 0; lane < 8; lane++) {
+      count += lanes[lane];
+    }
+  }
+  return count + count_scalar(values + i, length - i, value);
+}
+
+__attribute__((target("avx2"))) static int64_t sum_avx2(const int *values,
+                                                          size_t length) {
+  __m256i sum0 = _mm256_setzero_si256();
+  __m256i sum1 = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)(values + i));
+    __m128i hi = _mm_loadu_si128((const __m128i *)(values + i + 4));
+    sum0 = _mm256_add_epi64(sum0, _mm256_cvtepi32_epi64(lo));
+    sum1 = _mm256_add_epi64(sum1, _mm256_cvtepi32_epi64(hi));
+  }
+  int64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(sum0, sum1));
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         sum_scalar(values + i, length - i);
+}
+
+__attribute__((target("avx2"))) static int min_avx2(const int *values,
+                                                    size_t length) {
+  if (length < 8) {
+    return min_scalar(values, length);
+  }
+  __m256i min = _mm256_loadu_si256((const __m256i *)values);
+  size_t i = 8;
+  for (; i + 8 <= length; i += 8) {
+    min = _mm256_min_epi32(min,
+                           _mm256_loadu_si256((const __m256i *)(values + i)));
+  }
+  int lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, min);
+  int result = min_scalar(lanes, 8);
+  if (i < length) {
+    int tail = min_scalar(values + i, length - i);
+    result = tail < result ? tail : result;
+  }
+  return result;
+}
+
+__attribute__((target("avx2"))) static int max_avx2(const int *values,
+                                                    size_t length) {
+  if (length < 8) {
+    return max_scalar(values, length);
+  }
+  __m256i max = _mm256_loadu_si256((const __m256i *)values);
+  size_t i = 8;
+  for (; i + 8 <= length; i += 8) {
+    max = _mm256_max_epi32(max,
+                           _mm256_loadu_si256((const __m256i *)(values + i)));
+  }
+  int lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, max);
+  int result = max_scalar(lanes, 8);
+  if (i < length) {
+    int tail = max_scalar(values + i, length - i);
+    result = tail > result ? tail : result;
+  }
+  return result;
+}
+
+static const kernels AVX2_KERNELS = {
+    .find = find_avx2,
+    .count = count_avx2,
+    .sum = sum_avx2,
+    .min = min_avx2,
+    .max = max_avx2,
+};
+
+#endif
+
+// Gets the fastest set of kernels available at a given CPU level.
+static const kernels *kernels_for(cpu_level level) {
+#ifdef CPU_X86
+  if (level >= CPU_LEVEL_AVX2) {
+    return &AVX2_KERNELS;
+  }
+  if (level >= CPU_LEVEL_SSE2) {
+    return &SSE2_KERNELS;
+  }
+#endif
+  (void)level;
+  return &SCALAR_KERNELS;
+}
+
+CPU_DEFINE_KERNELS(kernels, kernels_for)
+
+bool vector_force_kernels(cpu_level level) { return force_kernels(level); }
+
+bool vector_find(vector *vec, int value, size_t *index) {
+  assert(vec != NULL &&
+         "Failed to find value in vector because vector pointer was NULL");
+  assert(index != NULL &&
+         "Failed to return position of value in vector because index pointer "
+         "was NULL");
+
+  size_t position = select_kernels()->find(vec->values, vec->length, value);
+  if (position == vec->length) {
+    return false;
+  }
+  *index = position;
+  return true;
+}
+
+bool vector_contains(vector *vec, int value) {
+  assert(vec != NULL &&
+         "Failed to check if vector contains value because pointer was NULL");
+  return select_kernels()->find(vec->values, vec->length, value) !=
+         vec->length;
+}
+
+size_t vector_count(vector *vec, int value) {
+  assert(vec != NULL &&
+         "Failed to count value in vector because pointer was NULL");
+  return select_kernels()->count(vec->values, vec->length, value);
+}
+
+int64_t vector_sum(vector *vec) {
+  assert(vec != NULL && "Failed to sum vector because pointer was NULL");
+  return select_kernels()->sum(vec->values, vec->length);
+}
+
+int vector_min(vector *vec) {
+  assert(vec != NULL &&
+         "Failed to get minimum of vector because pointer was NULL");
+  assert(vec->length > 0 &&
+         "Failed to get minimum of vector because it was empty");
+  return select_kernels()->min(vec->values, vec->length);
+}
+
+int vector_max(vector *vec) {
+  assert(vec != NULL &&
+         "Failed to get maximum of vector because pointer was NULL");
+  assert(vec->length > 0 &&
+         "Failed to get maximum of vector because it was empty");
+  return select_kernels()->max(vec->values, vec->length);
+}
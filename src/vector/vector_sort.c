@@ -0,0 +1,276 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "vector.h"
+#include "vector_inline.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of bits sorted on per radix sort pass.
+#define RADIX_BITS 8
+
+// Number of buckets per radix sort pass.
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+// Number of radix sort passes needed to sort 32-bit keys.
+#define RADIX_PASSES (32 / RADIX_BITS)
+
+// Arrays shorter than this are sorted with insertion sort, since building the
+// radix histograms would cost more than the sort itself.
+#define INSERTION_SORT_THRESHOLD 64
+
+// Vectors with fewer values than this per thread are sorted on the calling
+// thread only, since starting threads would cost more than it saves.
+#define MIN_VALUES_PER_THREAD 16384
+
+// Maps a value to an unsigned key with the same ordering by flipping the sign
+// bit.
+static uint32_t key(int value) { return (uint32_t)value ^ 0x80000000u; }
+
+static void insertion_sort(int *values, size_t length) {
+  for (size_t i = 1; i < length; i++) {
+    int value = values[i];
+    size_t j = i;
+    while (j > 0 && values[j - 1] > value) {
+      values[j] = values[j - 1];
+      j--;
+    }
+    values[j] = value;
+  }
+}
+
+// Sorts `length` values using an LSD radix sort. `tmp` must have room for
+// `length` values and is used as scratch space. The histograms for every pass
+// are built in a single read of the values, and passes whose digit is the
+// same for every value are skipped.
+static void radix_sort(int *values, int *tmp, size_t length) {
+  if (length < INSERTION_SORT_THRESHOLD) {
+    insertion_sort(values, length);
+    return;
+  }
+
+  size_t counts[RADIX_PASSES][RADIX_BUCKETS] = {{0}};
+  for (size_t i = 0; i < length; i++) {
+    uint32_t k = key(values[i]);
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+      counts[pass][(k >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+  }
+
+  int *src = values;
+  int *dst = tmp;
+  for (int pass = 0; pass < RADIX_PASSES; pass++) {
+    size_t *count = counts[pass];
+    int shift = pass * RADIX_BITS;
+    if (count[(key(src[0]) >> shift) & (RADIX_BUCKETS - 1)] == length) {
+      // Every value has the same digit, so this pass would not move anything
+      continue;
+    }
+
+    // Turn the counts into starting offsets
+    size_t offset = 0;
+    for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+      size_t bucket_count = count[bucket];
+      count[bucket] = offset;
+      offset += bucket_count;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+      int value = src[i];
+      dst[count[(key(value) >> shift) & (RADIX_BUCKETS - 1)]++] = value;
+    }
+
+    int *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != values) {
+    memcpy(values, src, length * sizeof(int));
+  }
+}
+
+// Merges the sorted runs `src[0..middle)` and `src[middle..length)` into
+// `dst`.
+static void merge(const int *src, int *dst, size_t middle, size_t length) {
+  size_t i = 0;
+  size_t j = middle;
+  size_t k = 0;
+  while (i < middle && j < length) {
+    dst[k++] = src[j] < src[i] ? src[j++] : src[i++];
+  }
+  memcpy(dst + k, src + i, (middle - i) * sizeof(int));
+  k += middle - i;
+  memcpy(dst + k, src + j, (length - j) * sizeof(int));
+}
+
+// A unit of work for a sorting thread. Runs start at `values` and `tmp`,
+// which point into the vector and the scratch array respectively.
+typedef struct sort_task {
+  int *values;
+  int *tmp;
+  // Length of the first run; only used when merging.
+  size_t middle;
+  size_t length;
+} sort_task;
+
+static void *sort_task_run(void *arg) {
+  sort_task *task = arg;
+  radix_sort(task->values, task->tmp, task->length);
+  return NULL;
+}
+
+static void *merge_task_run(void *arg) {
+  sort_task *task = arg;
+  merge(task->values, task->tmp, task->middle, task->length);
+  return NULL;
+}
+
+// Runs `count` tasks, one per thread. Tasks whose thread cannot be started are
+// run on the calling thread instead, so this never fails.
+static void run_tasks(void *(*run)(void *), sort_task *tasks, size_t count,
+                      pthread_t *threads, bool *started) {
+  for (size_t i = 1; i < count; i++) {
+    started[i] = pthread_create(&threads[i], NULL, run, &tasks[i]) == 0;
+    if (!started[i]) {
+      run(&tasks[i]);
+    }
+  }
+  if (count > 0) {
+    run(&tasks[0]);
+  }
+  for (size_t i = 1; i < count; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    }
+  }
+}
+
+bool vector_sort(vector *vec) {
+  assert(vec != NULL && "Failed to sort vector because pointer was NULL");
+
+  if (vec->length < INSERTION_SORT_THRESHOLD) {
+    insertion_sort(vec->values, vec->length);
+    return true;
+  }
+
+  int *tmp = malloc(vec->length * sizeof(int));
+  if (tmp == NULL) {
+    return false;
+  }
+  radix_sort(vec->values, tmp, vec->length);
+  free(tmp);
+  return true;
+}
+
+bool vector_sort_parallel(vector *vec, size_t nthreads) {
+  assert(vec != NULL && "Failed to sort vector because pointer was NULL");
+  assert(nthreads > 0 &&
+         "Failed to sort vector because number of threads was 0");
+
+  size_t length = vec->length;
+  if (nthreads > length / MIN_VALUES_PER_THREAD) {
+    nthreads = length / MIN_VALUES_PER_THREAD;
+  }
+  if (nthreads <= 1) {
+    return vector_sort(vec);
+  }
+
+  int *tmp = malloc(length * sizeof(int));
+  sort_task *tasks = malloc(nthreads * sizeof(sort_task));
+  size_t *bounds = malloc((nthreads + 1) * sizeof(size_t));
+  pthread_t *threads = malloc(nthreads * sizeof(pthread_t));
+  bool *started = malloc(nthreads * sizeof(bool));
+  bool ok = tmp != NULL && tasks != NULL && bounds != NULL &&
+            threads != NULL && started != NULL;
+  if (ok) {
+    // Sort one chunk per thread, spreading the remainder over the first ones
+    size_t remainder = length % nthreads;
+    for (size_t i = 0; i <= nthreads; i++) {
+      bounds[i] = length / nthreads * i + (i < remainder ? i : remainder);
+    }
+    for (size_t i = 0; i < nthreads; i++) {
+      tasks[i].values = vec->values + bounds[i];
+      tasks[i].tmp = tmp + bounds[i];
+      tasks[i].length = bounds[i + 1] - bounds[i];
+    }
+    run_tasks(sort_task_run, tasks, nthreads, threads, started);
+
+    // Merge pairs of neighbouring runs until one is left, alternating between
+    // the vector and the scratch array
+    int *src = vec->values;
+    int *dst = tmp;
+    size_t runs = nthreads;
+    while (runs > 1) {
+      size_t merges = runs / 2;
+      for (size_t i = 0; i < merges; i++) {
+        size_t lo = bounds[2 * i];
+        tasks[i].values = src + lo;
+        tasks[i].tmp = dst + lo;
+        tasks[i].middle = bounds[2 * i + 1] - lo;
+        tasks[i].length = bounds[2 * i + 2] - lo;
+      }
+      if (runs % 2 == 1) {
+        // The odd run out is carried over as is
+        size_t lo = bounds[runs - 1];
+        memcpy(dst + lo, src + lo, (length - lo) * sizeof(int));
+      }
+      run_tasks(merge_task_run, tasks, merges, threads, started);
+
+      for (size_t i = 0; i <= merges; i++) {
+        bounds[i] = bounds[2 * i < runs ? 2 * i : runs];
+      }
+      runs = (runs + 1) / 2;
+      bounds[runs] = length;
+
+      int *swap = src;
+      src = dst;
+      dst = swap;
+    }
+
+    if (src != vec->values) {
+      memcpy(vec->values, src, length * sizeof(int));
+    }
+  }
+
+  free(tmp);
+  free(tasks);
+  free(bounds);
+  free(threads);
+  free(started);
+  return ok;
+}
+
+bool vector_is_sorted(vector *vec) {
+  assert(vec != NULL &&
+         "Failed to check if vector was sorted because pointer was NULL");
+  for (size_t i = 1; i < vec->length; i++) {
+    if (vec->values[i] < vec->values[i - 1]) {
+      return false;
+    }
+  }
+  return true;
+}
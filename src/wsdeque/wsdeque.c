@@ -0,0 +1,222 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "wsdeque.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../cpu/cpu.h"
+
+// A circular array of items. Slots are atomic because a thief may read a slot
+// while the owner overwrites it after the thief has lost its race.
+typedef struct array {
+  // Array that this one replaced, so that it can be freed later.
+  struct array *retired;
+  int64_t capacity;
+  _Atomic(void *) items[];
+} array;
+
+// `top` and `bottom` count pointers ever stolen or popped from the top and
+// ever pushed to the bottom, so `bottom - top` is the length. They are signed
+// because popping briefly decrements `bottom` below `top` on an empty deque.
+typedef struct wsdeque {
+  // Written by thieves and by the owner when racing them for the last item
+  alignas(CACHE_LINE) _Atomic int64_t top;
+  // Written by the owner only
+  alignas(CACHE_LINE) _Atomic int64_t bottom;
+  _Atomic(array *) items;
+} wsdeque;
+
+static array *array_create(int64_t capacity) {
+  if ((uint64_t)capacity >
+      (SIZE_MAX - sizeof(array)) / sizeof(_Atomic(void *))) {
+    return NULL;
+  }
+
+  array *a = malloc(sizeof(array) + capacity * sizeof(_Atomic(void *)));
+  if (a == NULL) {
+    return NULL;
+  }
+  a->retired = NULL;
+  a->capacity = capacity;
+  return a;
+}
+
+static void *array_get(array *a, int64_t i) {
+  return atomic_load_explicit(&a->items[i & (a->capacity - 1)],
+                              memory_order_relaxed);
+}
+
+static void array_set(array *a, int64_t i, void *item) {
+  atomic_store_explicit(&a->items[i & (a->capacity - 1)], item,
+                        memory_order_relaxed);
+}
+
+// Replaces the array of a given deque, which holds the items from `top` to
+// `bottom`, with one of twice the capacity. Returns the new array, or NULL if
+// the deque is too large to grow or allocation fails.
+static array *grow(wsdeque *dq, array *a, int64_t top, int64_t bottom) {
+  if (a->capacity > INT64_MAX / 2) {
+    return NULL;
+  }
+  array *grown = array_create(a->capacity * 2);
+  if (grown == NULL) {
+    return NULL;
+  }
+
+  for (int64_t i = top; i < bottom; i++) {
+    array_set(grown, i, array_get(a, i));
+  }
+  grown->retired = a;
+  // Release, so that thieves that load the new array also see its items
+  atomic_store_explicit(&dq->items, grown, memory_order_release);
+  return grown;
+}
+
+wsdeque *wsdeque_create(size_t capacity) {
+  assert(capacity > 0 &&
+         "Failed to create work-stealing deque because capacity was 0");
+
+  int64_t rounded = 1;
+  while ((uint64_t)rounded < capacity) {
+    if (rounded > INT64_MAX / 2) {
+      return NULL;
+    }
+    rounded *= 2;
+  }
+
+  wsdeque *dq = aligned_alloc(CACHE_LINE, sizeof(wsdeque));
+  if (dq == NULL) {
+    return NULL;
+  }
+  array *a = array_create(rounded);
+  if (a == NULL) {
+    free(dq);
+    return NULL;
+  }
+  atomic_init(&dq->top, 0);
+  atomic_init(&dq->bottom, 0);
+  atomic_init(&dq->items, a);
+  return dq;
+}
+
+void wsdeque_destroy(wsdeque *dq) {
+  if (dq != NULL) {
+    array *a = atomic_load_explicit(&dq->items, memory_order_relaxed);
+    while (a != NULL) {
+      array *tmp = a;
+      a = a->retired;
+      free(tmp);
+    }
+    free(dq);
+  }
+}
+
+size_t wsdeque_length(wsdeque *dq) {
+  assert(dq != NULL &&
+         "Failed to get length of work-stealing deque because pointer was "
+         "NULL");
+
+  int64_t bottom = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+  int64_t top = atomic_load_explicit(&dq->top, memory_order_acquire);
+  return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+bool wsdeque_push(wsdeque *dq, void *item) {
+  assert(dq != NULL &&
+         "Failed to push item onto work-stealing deque because pointer was "
+         "NULL");
+
+  int64_t bottom = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+  int64_t top = atomic_load_explicit(&dq->top, memory_order_acquire);
+  array *a = atomic_load_explicit(&dq->items, memory_order_relaxed);
+  if (bottom - top > a->capacity - 1) {
+    a = grow(dq, a, top, bottom);
+    if (a == NULL) {
+      return false;
+    }
+  }
+
+  array_set(a, bottom, item);
+  // Make the item visible before the new bottom that lets thieves take it
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&dq->bottom, bottom + 1, memory_order_relaxed);
+  return true;
+}
+
+bool wsdeque_pop(wsdeque *dq, void **item) {
+  assert(dq != NULL && item != NULL &&
+         "Failed to pop item off work-stealing deque because at least one of "
+         "the pointers was NULL");
+
+  // Claim the bottom item first, then check whether a thief got to it
+  int64_t bottom = atomic_load_explicit(&dq->bottom, memory_order_relaxed) - 1;
+  array *a = atomic_load_explicit(&dq->items, memory_order_relaxed);
+  atomic_store_explicit(&dq->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t top = atomic_load_explicit(&dq->top, memory_order_relaxed);
+
+  if (top > bottom) {
+    // Empty
+    atomic_store_explicit(&dq->bottom, bottom + 1, memory_order_relaxed);
+    return false;
+  }
+
+  *item = array_get(a, bottom);
+  if (top < bottom) {
+    // More than one item left, so no thief can be after this one
+    return true;
+  }
+
+  // Last item, so race thieves for it
+  bool won = atomic_compare_exchange_strong_explicit(
+      &dq->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+  atomic_store_explicit(&dq->bottom, bottom + 1, memory_order_relaxed);
+  return won;
+}
+
+bool wsdeque_steal(wsdeque *dq, void **item) {
+  assert(dq != NULL && item != NULL &&
+         "Failed to steal item from work-stealing deque because at least one "
+         "of the pointers was NULL");
+
+  int64_t top = atomic_load_explicit(&dq->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t bottom = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+  if (top >= bottom) {
+    return false;
+  }
+
+  array *a = atomic_load_explicit(&dq->items, memory_order_acquire);
+  void *stolen = array_get(a, top);
+  if (!atomic_compare_exchange_strong_explicit(&dq->top, &top, top + 1,
+                                               memory_order_seq_cst,
+                                               memory_order_relaxed)) {
+    return false;
+  }
+  *item = stolen;
+  return true;
+}
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef WSDEQUE_H
+#define WSDEQUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A Chase-Lev work-stealing deque of pointers, typically to tasks. It has one
+// owner thread, which pushes and pops at the bottom without any atomic
+// read-modify-write in the common case, and any number of thief threads,
+// which steal from the top with a compare-and-swap. Owners work through their
+// own tasks newest first, while thieves take the oldest ones, which tend to
+// be the largest.
+//
+// The deque grows by doubling when full. Arrays that it has outgrown may
+// still be read by a thief in the middle of a steal, so they are kept until
+// the deque is destroyed. Since capacities double, they take up less memory
+// than the current array.
+typedef struct wsdeque wsdeque;
+
+// Creates a new deque with room for at least `capacity` pointers. The
+// capacity is rounded up to a power of two. Returns NULL if there is any
+// allocation errors or if the capacity is too large. `capacity` must not be
+// 0.
+wsdeque *wsdeque_create(size_t capacity);
+
+// Destroys a given deque, freeing the allocated memory but not what the
+// pointers in it point to. Does nothing if `dq` is NULL. No thread may use
+// the deque any longer.
+void wsdeque_destroy(wsdeque *dq);
+
+// Gets the number of pointers in a given deque. Unless called while no other
+// thread uses the deque, this is only a snapshot that may be out of date by
+// the time it is returned. `dq` must not be NULL.
+size_t wsdeque_length(wsdeque *dq);
+
+// Pushes a pointer onto the bottom of a given deque, growing it if it is
+// full. Returns false if the deque needs to grow but the growing operation
+// fails. Must only be called by the owner. `dq` must not be NULL.
+bool wsdeque_push(wsdeque *dq, void *item);
+
+// Pops the pointer at the bottom of a given deque into `item`. Returns false
+// if the deque is empty, which includes losing the last pointer to a thief.
+// Must only be called by the owner. `dq` and `item` must not be NULL.
+bool wsdeque_pop(wsdeque *dq, void **item);
+
+// Steals the pointer at the top of a given deque into `item`. Returns false if
+// the deque is empty or another thread took the pointer first, in which case
+// callers usually move on to another deque rather than retry. May be called
+// by any thread. `dq` and `item` must not be NULL.
+bool wsdeque_steal(wsdeque *dq, void **item);
+
+#endif
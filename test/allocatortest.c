@@ -0,0 +1,194 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/allocator/allocator.h"
+#include "../src/allocator/arena.h"
+#include "../src/allocator/fixed_pool.h"
+#include "../src/llist/llist.h"
+#include "../src/vector/vector.h"
+
+// An allocator that wraps malloc and keeps track of how many blocks and bytes
+// are outstanding, to check that every block is given back with the size it
+// was allocated with.
+typedef struct counter {
+  long blocks;
+  long bytes;
+} counter;
+
+static void *counting_allocate(void *context, size_t size) {
+  counter *c = context;
+  c->blocks++;
+  c->bytes += size;
+  return malloc(size);
+}
+
+static void *counting_reallocate(void *context, void *block, size_t old_size,
+                                 size_t new_size) {
+  counter *c = context;
+  c->bytes += (long)new_size - (long)old_size;
+  return realloc(block, new_size);
+}
+
+static void counting_deallocate(void *context, void *block, size_t size) {
+  counter *c = context;
+  c->blocks--;
+  c->bytes -= size;
+  free(block);
+}
+
+int main() {
+  // Arena
+  arena *a = arena_create(256);
+  allocator arena_alloc = arena_allocator(a);
+  char *p1 = arena_alloc.allocate(arena_alloc.context, 10);
+  char *p2 = arena_alloc.allocate(arena_alloc.context, 10);
+  printf("Arena used after two allocations: %lu\n", arena_used(a));
+  if ((uintptr_t)p1 % 16 != 0 || (uintptr_t)p2 % 16 != 0 || p1 == p2) {
+    fprintf(stderr, "Arena returned misaligned or overlapping blocks\n");
+    return 1;
+  }
+  char *p3 = arena_alloc.reallocate(arena_alloc.context, p2, 10, 100);
+  printf("Grew last allocation in place: %d\n", p3 == p2);
+  arena_alloc.deallocate(arena_alloc.context, p3, 100);
+  printf("Arena used after freeing it: %lu\n", arena_used(a));
+  char *big = arena_alloc.allocate(arena_alloc.context, 1000);
+  char *p4 = arena_alloc.allocate(arena_alloc.context, 10);
+  printf("Oversized allocation kept the block in use: %d\n", p4 == p2);
+  for (int i = 0; i < 1000; i++) {
+    big[i] = i;
+  }
+  arena_reset(a);
+  printf("Arena used after reset: %lu\n", arena_used(a));
+
+  // Vectors and lists in an arena, dropped by resetting it
+  for (int round = 0; round < 3; round++) {
+    vector *vec = vector_create_with_allocator(4, &arena_alloc);
+    llist *list = llist_create_with_allocator(&arena_alloc);
+    for (int i = 0; i < 1000; i++) {
+      vector_push(vec, i);
+      llist_push_back(list, i);
+    }
+    for (int i = 0; i < 900; i++) {
+      int value;
+      vector_pop(vec, &value);
+      llist_pop_front(list);
+    }
+    if (vector_get(vec, 99) != 99 || llist_get(list, 0) != 900) {
+      fprintf(stderr, "Arena vector or list lost values\n");
+      return 1;
+    }
+    printf("Round %d: arena used %lu bytes\n", round, arena_used(a));
+    arena_reset(a);
+  }
+  arena_destroy(a);
+
+  // Fixed pool
+  fixed_pool *pool = fixed_pool_create(24, 4);
+  allocator pool_alloc = fixed_pool_allocator(pool);
+  printf("Fixed pool object size: %lu\n", fixed_pool_object_size(pool));
+  void *objects[10];
+  for (int i = 0; i < 10; i++) {
+    objects[i] = pool_alloc.allocate(pool_alloc.context, 24);
+  }
+  printf("Too large allocation failed: %d\n",
+         pool_alloc.allocate(pool_alloc.context, 64) == NULL);
+  pool_alloc.deallocate(pool_alloc.context, objects[3], 24);
+  void *reused = pool_alloc.allocate(pool_alloc.context, 24);
+  printf("Freed object was reused: %d\n", reused == objects[3]);
+  vector *small = vector_create_with_allocator(1, &pool_alloc);
+  printf("Vector too large for pool failed: %d\n", small == NULL);
+  fixed_pool_destroy(pool);
+
+  // A list whose nodes come from a pool of objects the size of a node, which
+  // holds a value and two pointers, while the list itself comes from malloc
+  pool = fixed_pool_create(3 * sizeof(void *), 64);
+  pool_alloc = fixed_pool_allocator(pool);
+  allocator default_alloc = allocator_default();
+  llist *list = llist_create_with_allocators(&default_alloc, &pool_alloc);
+  if (list == NULL) {
+    fprintf(stderr, "List over a pool of nodes could not be created\n");
+    return 1;
+  }
+  for (int i = 0; i < 1000; i++) {
+    if (!llist_push_back(list, i)) {
+      fprintf(stderr, "List over a pool of nodes failed to push\n");
+      return 1;
+    }
+  }
+  for (int i = 0; i < 500; i++) {
+    llist_pop_front(list);
+  }
+  for (int i = 0; i < 500; i++) {
+    llist_push_front(list, i);
+  }
+  if (llist_length(list) != 1000 || llist_get(list, 0) != 499 ||
+      llist_get(list, 999) != 999) {
+    fprintf(stderr, "List over a pool of nodes lost values\n");
+    return 1;
+  }
+  printf("List over a pool of nodes holds %lu values\n", llist_length(list));
+  // The split off part gets its header from malloc too
+  llist *half = llist_split_at(list, 500);
+  if (half == NULL || llist_length(half) != 500 || llist_get(half, 0) != 500) {
+    fprintf(stderr, "List over a pool of nodes failed to split\n");
+    return 1;
+  }
+  llist_destroy(half);
+  llist_destroy(list);
+  fixed_pool_destroy(pool);
+
+  // Every block given back with the right size
+  counter c = {0, 0};
+  allocator counting = {
+      .allocate = counting_allocate,
+      .reallocate = counting_reallocate,
+      .deallocate = counting_deallocate,
+      .context = &c,
+  };
+  vector *vec = vector_create_with_allocator(2, &counting);
+  list = llist_create_with_allocator(&counting);
+  llist *other = llist_create_with_allocator(&counting);
+  for (int i = 0; i < 10000; i++) {
+    vector_push(vec, i);
+    llist_push_back(i % 2 == 0 ? list : other, i);
+  }
+  llist_concat(list, other);
+  llist *rest = llist_split_at(list, 5000);
+  printf("Outstanding: %ld blocks\n", c.blocks);
+  for (int i = 0; i < 9990; i++) {
+    int value;
+    vector_pop(vec, &value);
+  }
+  vector_destroy(vec);
+  llist_destroy(rest);
+  llist_destroy(other);
+  llist_destroy(list);
+  if (c.blocks != 0 || c.bytes != 0) {
+    fprintf(stderr, "Leaked %ld blocks of %ld bytes\n", c.blocks, c.bytes);
+    return 1;
+  }
+  printf("All blocks given back\n");
+}
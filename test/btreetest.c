@@ -0,0 +1,290 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/btree/btree.h"
+#include "../src/vector/vector.h"
+
+// Keys of the checks against arrays are taken from [-RANGE, RANGE).
+#define RANGE 20000
+
+// Checks that a tree holds exactly the entries flagged in arrays indexed by
+// key + RANGE, in order.
+static bool matches(btree *tree, bool *present, int *expected) {
+  size_t length = 0;
+  btree_iterator it = btree_begin(tree);
+  int key;
+  int value;
+  for (int i = 0; i < 2 * RANGE; i++) {
+    if (!present[i]) {
+      continue;
+    }
+    length++;
+    if (!btree_iterator_next(&it, &key, &value) || key != i - RANGE ||
+        value != expected[i]) {
+      fprintf(stderr, "B+tree iterated to the wrong entry at key %d\n",
+              i - RANGE);
+      return false;
+    }
+    int got;
+    if (!btree_get(tree, i - RANGE, &got) || got != expected[i]) {
+      fprintf(stderr, "B+tree got the wrong value for key %d\n", i - RANGE);
+      return false;
+    }
+  }
+  if (btree_iterator_next(&it, &key, &value) ||
+      btree_length(tree) != length) {
+    fprintf(stderr, "B+tree has too many entries\n");
+    return false;
+  }
+  return true;
+}
+
+// Puts an entry, given by its index into the arrays of matches, into a tree
+// and the arrays.
+static void put(btree *tree, bool *present, int *expected, int k, int value) {
+  btree_put(tree, k - RANGE, value);
+  present[k] = true;
+  expected[k] = value;
+}
+
+// Removes an entry, given by its index into the arrays of matches, from a
+// tree and the arrays. Returns false if the tree removed something else.
+static bool take(btree *tree, bool *present, int *expected, int k) {
+  int removed;
+  bool was_present = btree_remove(tree, k - RANGE, &removed);
+  if (was_present != present[k] || (was_present && removed != expected[k])) {
+    fprintf(stderr, "B+tree removed the wrong entry for key %d\n", k - RANGE);
+    return false;
+  }
+  present[k] = false;
+  return true;
+}
+
+int main() {
+  int range_keys[10];
+  int range_values[10];
+  size_t count;
+  btree *tree = btree_create();
+  btree_put(tree, 5, 50);
+  btree_put(tree, -1, -10);
+  btree_put(tree, 3, 30);
+  btree_put(tree, 5, 55);
+  btree_print(tree);
+  int key = 0;
+  int value = 0;
+  btree_get(tree, 5, &value);
+  printf("Length: %lu, get 5: %d, contains 4: %d\n", btree_length(tree), value,
+         btree_contains(tree, 4));
+  btree_remove(tree, -1, &value);
+  printf("Removed -1: %d, remove 4: %d\n", value,
+         btree_remove(tree, 4, NULL));
+  btree_print(tree);
+  btree_put(tree, INT_MAX, 1);
+  btree_put(tree, INT_MIN, 2);
+  count = btree_range(tree, 4, INT_MAX, range_keys, range_values, 10);
+  printf("Keys from 4 up: %lu, contains INT_MAX: %d, contains INT_MIN: %d\n",
+         count, btree_contains(tree, INT_MAX), btree_contains(tree, INT_MIN));
+  btree_destroy(tree);
+
+  // Enough entries for a few levels
+  vector *keys = vector_create(1);
+  for (int i = 0; i < 100000; i++) {
+    vector_push(keys, i * 2);
+  }
+  vector_push(keys, 199998);
+  tree = btree_create_from_vector(keys, NULL);
+  btree_first(tree, &key, &value);
+  printf("Bulk loaded %lu keys, first: %d", btree_length(tree), key);
+  btree_last(tree, &key, &value);
+  printf(", last: %d\n", key);
+  btree_iterator it = btree_lower_bound(tree, 1001);
+  btree_iterator_next(&it, &key, &value);
+  printf("Lower bound of 1001: %d\n", key);
+  count = btree_range(tree, 63, 81, range_keys, range_values, 10);
+  printf("Keys between 63 and 81:");
+  for (size_t i = 0; i < count; i++) {
+    printf(" %d", range_keys[i]);
+  }
+  printf("\n");
+  for (int i = 0; i < 100000; i += 2) {
+    btree_remove(tree, i * 2, NULL);
+  }
+  printf("Removed every other key, length: %lu, contains 4: %d, contains 6: "
+         "%d\n",
+         btree_length(tree), btree_contains(tree, 4), btree_contains(tree, 6));
+  btree_destroy(tree);
+  vector_destroy(keys);
+
+  // Check node searches with the kernels of every level the machine
+  // supports, including keys next to the INT_MAX padding of nodes that are
+  // not full
+  const char *level_names[3] = {"scalar", "SSE2", "AVX2"};
+  for (int level = CPU_LEVEL_SCALAR; level <= CPU_LEVEL_AVX2; level++) {
+    if (!btree_force_kernels(level)) {
+      continue;
+    }
+    tree = btree_create();
+    for (int i = 0; i < 5000; i++) {
+      btree_put(tree, i * 3 - 7500, i);
+    }
+    btree_put(tree, INT_MIN, -1);
+    btree_put(tree, INT_MAX - 1, -2);
+    btree_put(tree, INT_MAX, -3);
+    for (int k = -7503; k <= 7503; k++) {
+      bool present = k >= -7500 && k <= 7497 && (k + 7500) % 3 == 0;
+      int bound = k <= -7500  ? -7500
+                  : k > 7497 ? INT_MAX - 1
+                             : -7500 + (k + 7500 + 2) / 3 * 3;
+      it = btree_lower_bound(tree, k);
+      if (btree_contains(tree, k) != present ||
+          !btree_iterator_next(&it, &key, &value) || key != bound) {
+        fprintf(stderr, "%s kernels searched wrongly for key %d\n",
+                level_names[level], k);
+        return 1;
+      }
+    }
+    if (!btree_get(tree, INT_MAX, &value) || value != -3 ||
+        !btree_get(tree, INT_MIN, &value) || value != -1 ||
+        btree_contains(tree, INT_MAX - 2)) {
+      fprintf(stderr, "%s kernels missed extreme keys\n", level_names[level]);
+      return 1;
+    }
+    printf("%s kernels find every key\n", level_names[level]);
+    btree_destroy(tree);
+  }
+  btree_force_kernels(cpu_level_supported());
+
+  // Check puts and removes in the orders that stress each way of keeping
+  // the tree balanced against arrays indexed by key
+  bool *present = calloc(2 * RANGE, sizeof(bool));
+  int *expected = malloc(2 * RANGE * sizeof(int));
+
+  // Ascending puts always split the last node of each level and descending
+  // ones the first
+  for (int descending = 0; descending < 2; descending++) {
+    tree = btree_create();
+    for (int i = 0; i < 2 * RANGE; i++) {
+      int k = descending ? 2 * RANGE - 1 - i : i;
+      put(tree, present, expected, k, i);
+    }
+    if (!matches(tree, present, expected)) {
+      return 1;
+    }
+    // Removing from the front tops up the first node of each level from its
+    // right sibling, and removing from the back the last one from its left
+    // sibling, until they have to merge
+    for (int i = 0; i < RANGE; i++) {
+      if (!take(tree, present, expected, i) ||
+          !take(tree, present, expected, 2 * RANGE - 1 - i)) {
+        return 1;
+      }
+      if (i % 1000 == 0 && !matches(tree, present, expected)) {
+        return 1;
+      }
+    }
+    // The last removes collapse the root level by level
+    int first;
+    if (btree_length(tree) != 0 || btree_first(tree, &first, &value) ||
+        !matches(tree, present, expected)) {
+      fprintf(stderr, "B+tree is not empty after removing every key\n");
+      return 1;
+    }
+    put(tree, present, expected, 7, 70);
+    if (!matches(tree, present, expected)) {
+      return 1;
+    }
+    take(tree, present, expected, 7);
+    btree_destroy(tree);
+  }
+  printf("B+tree splits, borrows and merges at both ends\n");
+
+  // A bulk loaded tree has as few leaves as its entries fit in, which for
+  // this many entries are all full, so putting keys between its keys splits
+  // in the middle of every leaf. Removing the bulk loaded keys again
+  // leaves neighbouring nodes that are often both small, so the tree borrows
+  // and merges in its interior.
+  int *sorted_keys = malloc(RANGE * sizeof(int));
+  int *sorted_values = malloc(RANGE * sizeof(int));
+  for (int i = 0; i < RANGE; i++) {
+    sorted_keys[i] = 2 * i - RANGE;
+    sorted_values[i] = i;
+    present[2 * i] = true;
+    expected[2 * i] = i;
+  }
+  tree = btree_create_from_sorted(sorted_keys, sorted_values, RANGE);
+  for (int i = 1; i < 2 * RANGE; i += 2) {
+    put(tree, present, expected, i, -i);
+  }
+  if (!matches(tree, present, expected)) {
+    return 1;
+  }
+  for (int i = 0; i < 2 * RANGE; i += 2) {
+    if (!take(tree, present, expected, i)) {
+      return 1;
+    }
+  }
+  if (!matches(tree, present, expected)) {
+    return 1;
+  }
+  // Then thin out what is left with a stride, so that removes land all over
+  // the tree
+  for (int i = 0; i < RANGE; i++) {
+    int k = (int)((long long)i * 7919 % RANGE) * 2 + 1;
+    if (i % 3 != 0 && !take(tree, present, expected, k)) {
+      return 1;
+    }
+  }
+  if (!matches(tree, present, expected)) {
+    return 1;
+  }
+
+  int low = -RANGE / 2;
+  int high = RANGE / 2;
+  count = btree_range(tree, low, high, sorted_keys, sorted_values, RANGE);
+  size_t in_range = 0;
+  for (int k = low; k <= high; k++) {
+    if (present[k + RANGE]) {
+      if (in_range >= count || sorted_keys[in_range] != k ||
+          sorted_values[in_range] != expected[k + RANGE]) {
+        fprintf(stderr, "B+tree range was wrong at key %d\n", k);
+        return 1;
+      }
+      in_range++;
+    }
+  }
+  if (count != in_range) {
+    fprintf(stderr, "B+tree range had too many entries\n");
+    return 1;
+  }
+  printf("B+tree of %lu entries splits, borrows and merges in its interior\n",
+         btree_length(tree));
+  btree_destroy(tree);
+  free(sorted_values);
+  free(sorted_keys);
+  free(expected);
+  free(present);
+}
@@ -0,0 +1,223 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/clist/clist.h"
+
+// Number of values the lists checked against arrays start out with.
+#define LENGTH 100
+
+// Checks that a given list holds exactly the values of a given array. Lookups
+// in the second half walk back from the tail, so both directions of the links
+// are checked.
+static bool holds(clist *list, const int *values, size_t length) {
+  if (clist_length(list) != length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (clist_get(list, i) != values[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void insert_at(int *values, size_t *length, size_t index, int value) {
+  memmove(values + index + 1, values + index,
+          (*length - index) * sizeof(int));
+  values[index] = value;
+  (*length)++;
+}
+
+static void remove_at(int *values, size_t *length, size_t index) {
+  memmove(values + index, values + index + 1,
+          (*length - index - 1) * sizeof(int));
+  (*length)--;
+}
+
+int main() {
+  clist *list = clist_create();
+  clist_print(list);
+
+  clist_insert(list, 0, 42);
+  clist_print(list);
+
+  clist_insert(list, 0, 84);
+  clist_print(list);
+
+  clist_insert(list, 2, 168);
+  clist_print(list);
+
+  clist_insert(list, 1, 336);
+  clist_print(list);
+
+  printf("\n");
+
+  int value = clist_remove(list, 2);
+  printf("Removed %d\n", value);
+  clist_print(list);
+
+  printf("\n");
+
+  for (int i = 0; i < 10; i++) {
+    clist_push_back(list, i * 2);
+    clist_push_front(list, i * 2);
+    clist_print(list);
+  }
+
+  printf("\n");
+
+  value = clist_pop_back(list);
+  printf("Popped %d from back\n", value);
+  clist_print(list);
+
+  value = clist_pop_front(list);
+  printf("Popped %d from front\n", value);
+  clist_print(list);
+
+  printf("\n");
+
+  value = clist_back(list);
+  printf("Peeked %d from back\n", value);
+  clist_print(list);
+
+  value = clist_front(list);
+  printf("Peeked %d from front\n", value);
+  clist_print(list);
+
+  printf("\n");
+
+  clist_set(list, 9, 12345);
+
+  for (size_t i = 0; i < clist_length(list); i++) {
+    printf("%d ", clist_get(list, i));
+  }
+  printf("\n");
+
+  printf("\n");
+
+  size_t position;
+  for (int i = clist_length(list) - 1; i >= 0; i--) {
+    value = clist_get(list, i);
+    if (clist_position(list, value, &position)) {
+      printf("Found %d at index %lu\n", value, position);
+    } else {
+      printf("Did not find %d\n", value);
+    }
+  }
+  if (clist_position(list, 54321, &position)) {
+    printf("Found %d at index %lu\n", 54321, position);
+  } else {
+    printf("Did not find %d\n", 54321);
+  }
+
+  printf("\n");
+
+  int values[21] = {16,  14, 12, 10, 8, 6, 4,  2,  0,  12345, 336,
+                    168, 0,  2,  4,  6, 8, 10, 12, 14, 16};
+  clist *list2 = clist_create_from_values(values, 21);
+  clist_print(list2);
+
+  char *equals = clist_equals(list, list) ? "true" : "false";
+  printf("list == list? %s\n", equals);
+  equals = clist_equals(list, list2) ? "true" : "false";
+  printf("list == list2? %s\n", equals);
+  equals = clist_equals(list, list2) ? "true" : "false";
+  clist_destroy(list2);
+
+  list2 = clist_create();
+  clist_print(list2);
+  clist_push_back(list2, 42);
+  equals = clist_equals(list, list2) ? "true" : "false";
+  printf("list == list2? %s\n", equals);
+  clist_destroy(list2);
+
+  printf("\n");
+
+  char *contains;
+  for (int i = clist_length(list) - 1; i >= 0; i--) {
+    value = clist_get(list, i);
+    contains = clist_contains(list, value) ? "true" : "false";
+    printf("list contains %d? %s\n", value, contains);
+  }
+  value = 54321;
+  contains = clist_contains(list, value) ? "true" : "false";
+  printf("list contains %d? %s\n", value, contains);
+
+  printf("\n");
+
+  clist_clear(list);
+  clist_print(list);
+
+  clist_destroy(list);
+
+  printf("\n");
+
+  // A list created from values has no spare room. Removing every other value
+  // threads the free list through the whole node array, so the inserts that
+  // follow reuse nodes scattered all over it before the array has to grow.
+  static int expected[3 * LENGTH];
+  for (int i = 0; i < LENGTH; i++) {
+    expected[i] = i;
+  }
+  list = clist_create_from_values(expected, LENGTH);
+  size_t length = LENGTH;
+  for (size_t at = 1; at < length; at++) {
+    if (clist_remove(list, at) != expected[at]) {
+      fprintf(stderr, "Compact list removed the wrong value at %lu\n", at);
+      return 1;
+    }
+    remove_at(expected, &length, at);
+  }
+  if (!holds(list, expected, length)) {
+    fprintf(stderr, "Compact list lost values freeing nodes\n");
+    return 1;
+  }
+  for (int i = 0; i < 2 * LENGTH; i++) {
+    // Recycled nodes end up linked in an order unrelated to their indices
+    size_t at = (size_t)i * 7 % (length + 1);
+    clist_insert(list, at, -i);
+    insert_at(expected, &length, at, -i);
+  }
+  if (!holds(list, expected, length)) {
+    fprintf(stderr, "Compact list lost values reusing nodes\n");
+    return 1;
+  }
+  printf("Compact list reuses freed nodes and grows past them\n");
+
+  // A clone only has room for the nodes in use and keeps the free list, so
+  // it grows and recycles on its own without touching the original
+  clist *clone = clist_clone(list);
+  clist_pop_front(list);
+  clist_pop_back(list);
+  clist_push_back(clone, 1000);
+  clist_insert(clone, 1, 1001);
+  if (!holds(list, expected + 1, length - 2) ||
+      clist_length(clone) != length + 2 || clist_get(clone, 0) != expected[0] ||
+      clist_get(clone, 1) != 1001 || clist_back(clone) != 1000) {
+    fprintf(stderr, "Compact list and its clone share nodes\n");
+    return 1;
+  }
+  clist_destroy(clone);
+
+  // Clearing keeps the node array, which is then handed out again from the
+  // start, with the old free list gone
+  clist_clear(list);
+  length = 0;
+  for (int i = 0; i < LENGTH; i++) {
+    if (i % 2 == 0) {
+      clist_push_front(list, i);
+      insert_at(expected, &length, 0, i);
+    } else {
+      clist_push_back(list, i);
+      insert_at(expected, &length, length, i);
+    }
+  }
+  if (!holds(list, expected, length)) {
+    fprintf(stderr, "Compact list lost values after clearing\n");
+    return 1;
+  }
+  printf("Compact list reuses its nodes after clearing and cloning\n");
+  clist_destroy(list);
+}
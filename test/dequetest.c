@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/deque/deque.h"
+
+// Checks that a given deque holds exactly the values of a given array.
+static bool holds(deque *dq, const int *values, size_t length) {
+  if (deque_length(dq) != length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (deque_get(dq, i) != values[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  deque *dq = deque_create(3);
+  printf("Capacity: %lu\n", deque_capacity(dq));
+  deque_print(dq);
+
+  // Used as a queue
+  for (int i = 0; i < 3; i++) {
+    deque_push_back(dq, i);
+  }
+  printf("Popped front: %d\n", deque_pop_front(dq));
+  deque_push_back(dq, 3);
+  deque_push_back(dq, 4);
+  deque_print(dq);
+  printf("Capacity: %lu\n", deque_capacity(dq));
+
+  // Used as a stack from the front, growing while wrapped around
+  deque_push_front(dq, 0);
+  deque_push_front(dq, -1);
+  deque_print(dq);
+  printf("Front: %d, back: %d, [3]: %d\n", deque_front(dq), deque_back(dq),
+         deque_get(dq, 3));
+  printf("Length: %lu, capacity: %lu\n", deque_length(dq),
+         deque_capacity(dq));
+  printf("Popped back: %d\n", deque_pop_back(dq));
+  deque_set(dq, 0, 42);
+  deque_print(dq);
+
+  int values[10] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  deque_push_back_many(dq, values, 10);
+  printf("Pushed 10 values\n");
+  deque_print(dq);
+  int popped[8];
+  size_t count = deque_pop_front_many(dq, popped, 8);
+  printf("Popped %lu values:", count);
+  for (size_t i = 0; i < count; i++) {
+    printf(" %d", popped[i]);
+  }
+  printf("\n");
+  deque_print(dq);
+  deque_clear(dq);
+  printf("Cleared, empty: %d\n", deque_empty(dq));
+  deque_destroy(dq);
+
+  // Start from every slot of a ring of 16 values and every length, so that
+  // bulk pushes wrap around the end of the ring and grow it while wrapped,
+  // bulk pops copy across the end, and pushes onto the front wrap below slot
+  // 0. The values are checked against a plain array after each step.
+  int expected[64];
+  int buffer[64];
+  size_t checked = 0;
+  for (size_t head = 0; head < 16; head++) {
+    for (size_t length = 0; length <= 16; length++) {
+      for (size_t extra = 0; extra <= 20; extra += 5) {
+        dq = deque_create(16);
+        for (size_t i = 0; i < head; i++) {
+          deque_push_back(dq, -1);
+          deque_pop_front(dq);
+        }
+        size_t n = 0;
+        for (size_t i = 0; i < length; i++) {
+          deque_push_back(dq, n);
+          expected[n] = n;
+          n++;
+        }
+        for (size_t i = 0; i < extra; i++) {
+          buffer[i] = n + i;
+          expected[n + i] = n + i;
+        }
+        deque_push_back_many(dq, buffer, extra);
+        n += extra;
+        if (!holds(dq, expected, n)) {
+          fprintf(stderr, "Deque lost values pushing %lu onto %lu from "
+                          "slot %lu\n", extra, length, head);
+          return 1;
+        }
+
+        size_t popped = deque_pop_front_many(dq, buffer, 7);
+        for (size_t i = 0; i < popped; i++) {
+          if (buffer[i] != expected[i]) {
+            fprintf(stderr, "Deque popped wrong values in bulk\n");
+            return 1;
+          }
+        }
+        memmove(expected + 3, expected + popped, (n - popped) * sizeof(int));
+        n = n - popped + 3;
+        for (int i = 0; i < 3; i++) {
+          deque_push_front(dq, -1 - i);
+          expected[2 - i] = -1 - i;
+        }
+        if (!holds(dq, expected, n) || deque_pop_back(dq) != expected[n - 1]) {
+          fprintf(stderr, "Deque lost values pushing onto the front from "
+                          "slot %lu\n", head);
+          return 1;
+        }
+        deque_destroy(dq);
+        checked++;
+      }
+    }
+  }
+  printf("Deque matches arrays from %lu starting points around the ring\n",
+         checked);
+}
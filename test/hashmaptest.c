@@ -0,0 +1,183 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "../src/hashmap/hashmap.h"
+
+// Capacity of the maps that clusters of keys are built in. Their tables are
+// several groups long, so that a key shifted back wrongly is cut off from its
+// home by an empty slot.
+#define CLUSTER_CAPACITY 40
+
+// Finds the home slot of a given key in a map created with CLUSTER_CAPACITY,
+// which is the slot it lands in when put into an empty one.
+static size_t home_of(int key) {
+  hashmap *map = hashmap_create(CLUSTER_CAPACITY);
+  hashmap_put(map, key, 0);
+  size_t position = 0;
+  int value;
+  hashmap_next(map, &position, &key, &value);
+  hashmap_destroy(map);
+  return position - 1;
+}
+
+// Checks that a given map holds every key of a cluster but the one at
+// `removed`, each mapped to its index in the cluster.
+static bool holds_cluster(hashmap *map, const int *cluster, size_t length,
+                          size_t removed) {
+  for (size_t i = 0; i < length; i++) {
+    int value;
+    bool found = hashmap_get(map, cluster[i], &value);
+    if (found != (i != removed) || (found && value != (int)i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  hashmap *map = hashmap_create(0);
+  printf("Length: %lu, capacity: %lu\n", hashmap_length(map),
+         hashmap_capacity(map));
+  hashmap_print(map);
+
+  hashmap_put(map, 1, 10);
+  hashmap_put(map, 2, 20);
+  hashmap_put(map, -3, 30);
+  hashmap_put(map, 2, 22);
+  int value = 0;
+  bool found = hashmap_get(map, 2, &value);
+  printf("Get 2: %d (found: %d)\n", value, found);
+  printf("Contains -3: %d, contains 4: %d\n", hashmap_contains(map, -3),
+         hashmap_contains(map, 4));
+  found = hashmap_remove(map, 1, &value);
+  printf("Removed 1: %d (found: %d)\n", value, found);
+  printf("Remove 1 again: %d\n", hashmap_remove(map, 1, NULL));
+  printf("Length: %lu\n", hashmap_length(map));
+
+  int keys[100];
+  int values[100];
+  for (int i = 0; i < 100; i++) {
+    keys[i] = i * 7;
+    values[i] = -i;
+  }
+  hashmap_put_many(map, keys, values, 100);
+  printf("Put 100 entries, length: %lu, capacity: %lu\n", hashmap_length(map),
+         hashmap_capacity(map));
+  hashmap_set_max_load_factor(map, 0.5);
+  printf("Max load factor: %.2f, capacity: %lu\n",
+         hashmap_get_max_load_factor(map), hashmap_capacity(map));
+  long long sum = 0;
+  size_t position = 0;
+  int key;
+  while (hashmap_next(map, &position, &key, &value)) {
+    sum += key + value;
+  }
+  printf("Sum of keys and values: %lld\n", sum);
+  hashmap_clear(map);
+  printf("Cleared, length: %lu\n", hashmap_length(map));
+  hashmap_print(map);
+  hashmap_destroy(map);
+
+  // Build a cluster that wraps around the end of a map: keys whose home is
+  // one of its last two slots are put first and spill over into the first
+  // slots, pushing keys whose home is one of the first two slots further
+  // along. Probing the cluster loads groups that cross the end of the table,
+  // and removing any key from it has to shift the keys after it back across
+  // the end without moving any of them before its home.
+  size_t cluster_length = CLUSTER_CAPACITY;
+  size_t last_home = 0;
+  for (int k = 0; k < 5000; k++) {
+    size_t home = home_of(k);
+    last_home = home > last_home ? home : last_home;
+  }
+  int cluster[64];
+  size_t at_end = 0;
+  size_t at_start = 0;
+  for (int k = 0; at_end + at_start < cluster_length; k++) {
+    size_t home = home_of(k);
+    if (home + 1 >= last_home && at_end < cluster_length / 2) {
+      cluster[at_end++] = k;
+    } else if (home <= 1 && at_start < cluster_length - cluster_length / 2) {
+      cluster[cluster_length - 1 - at_start++] = k;
+    }
+  }
+  for (size_t removed = 0; removed < cluster_length; removed++) {
+    map = hashmap_create(CLUSTER_CAPACITY);
+    for (size_t i = 0; i < cluster_length; i++) {
+      hashmap_put(map, cluster[i], i);
+    }
+    if (!hashmap_remove(map, cluster[removed], &value) ||
+        value != (int)removed ||
+        !holds_cluster(map, cluster, cluster_length, removed)) {
+      fprintf(stderr, "Hash map lost keys removing key %d of a cluster\n",
+              cluster[removed]);
+      return 1;
+    }
+    // Taking out the rest one by one shifts back what is left every time
+    for (size_t i = 0; i < cluster_length; i++) {
+      if (i != removed && !hashmap_remove(map, cluster[i], NULL)) {
+        fprintf(stderr, "Hash map lost key %d of a cluster\n", cluster[i]);
+        return 1;
+      }
+    }
+    if (hashmap_length(map) != 0) {
+      fprintf(stderr, "Hash map is not empty after removing a cluster\n");
+      return 1;
+    }
+    hashmap_destroy(map);
+  }
+  printf("Hash map shifts back clusters of %lu keys across the end of the "
+         "table\n",
+         cluster_length);
+
+  // Growing rehashes the cluster into a larger table where it no longer
+  // wraps, and removes keep working there
+  map = hashmap_create(CLUSTER_CAPACITY);
+  for (size_t i = 0; i < cluster_length; i++) {
+    hashmap_put(map, cluster[i], i);
+  }
+  for (int i = 0; i < 1000; i++) {
+    keys[i % 100] = 1000 + i;
+    values[i % 100] = 1000 + i;
+    if (i % 100 == 99) {
+      hashmap_put_many(map, keys, values, 100);
+    }
+  }
+  hashmap_remove(map, cluster[0], NULL);
+  if (hashmap_length(map) != cluster_length + 999 ||
+      !holds_cluster(map, cluster, cluster_length, 0)) {
+    fprintf(stderr, "Hash map lost keys of a cluster while growing\n");
+    return 1;
+  }
+  for (int k = 1000; k < 2000; k++) {
+    if (!hashmap_get(map, k, &value) || value != k) {
+      fprintf(stderr, "Hash map lost key %d while growing\n", k);
+      return 1;
+    }
+  }
+  printf("Hash map keeps a cluster while growing to %lu entries\n",
+         hashmap_length(map));
+  hashmap_destroy(map);
+}
@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+
+#include "../src/ilist/ilist.h"
+
+typedef struct timer {
+  int deadline;
+  ilist_link link;
+} timer;
+
+static void print(ilist *list) {
+  printf("[ ");
+  ILIST_FOR_EACH(l, list) {
+    timer *t = ILIST_CONTAINER_OF(l, timer, link);
+    printf(l == ilist_front(list) ? "%d" : " <-> %d", t->deadline);
+  }
+  printf(" ]\n");
+}
+
+int main() {
+  timer timers[8];
+  for (int i = 0; i < 8; i++) {
+    timers[i].deadline = i * 10;
+  }
+
+  ilist list;
+  ilist_init(&list);
+  print(&list);
+
+  ilist_push_back(&list, &timers[1].link);
+  ilist_push_back(&list, &timers[2].link);
+  ilist_push_front(&list, &timers[0].link);
+  ilist_insert_after(&list, &timers[2].link, &timers[4].link);
+  ilist_insert_before(&list, &timers[4].link, &timers[3].link);
+  print(&list);
+  printf("Length: %lu\n", ilist_length(&list));
+
+  ilist_remove(&list, &timers[2].link);
+  printf("Removed 20\n");
+  print(&list);
+
+  ilist_link *front = ilist_pop_front(&list);
+  ilist_link *back = ilist_pop_back(&list);
+  printf("Popped %d and %d\n", ILIST_CONTAINER_OF(front, timer, link)->deadline,
+         ILIST_CONTAINER_OF(back, timer, link)->deadline);
+  print(&list);
+
+  ilist other;
+  ilist_init(&other);
+  for (int i = 5; i < 8; i++) {
+    ilist_push_back(&other, &timers[i].link);
+  }
+  ilist_concat(&list, &other);
+  printf("Concatenated\n");
+  print(&list);
+  print(&other);
+
+  ILIST_FOR_EACH_SAFE(l, tmp, &list) {
+    if (ILIST_CONTAINER_OF(l, timer, link)->deadline % 20 == 0) {
+      ilist_remove(&list, l);
+    }
+  }
+  printf("Removed multiples of 20\n");
+  print(&list);
+
+  int expected[] = {10, 30, 50, 70};
+  size_t i = 0;
+  ILIST_FOR_EACH(l, &list) {
+    if (i >= 4 || ILIST_CONTAINER_OF(l, timer, link)->deadline != expected[i]) {
+      fprintf(stderr, "Intrusive list does not match expected values\n");
+      return 1;
+    }
+    i++;
+  }
+  if (i != 4 || ilist_length(&list) != 4 ||
+      ilist_back(&list)->previous != &timers[5].link) {
+    fprintf(stderr, "Intrusive list has broken links\n");
+    return 1;
+  }
+
+  while (!ilist_empty(&list)) {
+    ilist_pop_back(&list);
+  }
+  print(&list);
+}
@@ -0,0 +1,282 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/intset/intset.h"
+#include "../src/vector/vector.h"
+
+// Values of the randomized check are taken from [-RANGE, RANGE), which spans
+// several chunks on both sides of 0.
+#define RANGE 300000
+
+// Fills a set and a matching array of flags with a random mix of sparse
+// values, dense stretches and long runs, so that all containers are used.
+static intset *random_set(bool *expected) {
+  vector *vec = vector_create(1);
+  for (int i = 0; i < 2 * RANGE; i++) {
+    expected[i] = false;
+  }
+  for (int stretch = 0; stretch < 12; stretch++) {
+    int start = rand() % (2 * RANGE - 70000);
+    int kind = rand() % 3;
+    int length = kind == 0 ? 3000 : 70000;
+    for (int i = start; i < start + length; i++) {
+      // Sparse, dense or consecutive
+      bool in = kind == 0 ? rand() % 20 == 0
+                : kind == 1 ? rand() % 2 == 0
+                            : true;
+      if (in) {
+        vector_push(vec, i - RANGE);
+        expected[i] = true;
+      }
+    }
+  }
+  intset *set = intset_create_from_vector(vec);
+  vector_destroy(vec);
+
+  // Edit the set one value at a time too, which converts between containers
+  for (int i = 0; i < 20000; i++) {
+    int value = rand() % (2 * RANGE);
+    if (rand() % 2 == 0) {
+      intset_add(set, value - RANGE);
+      expected[value] = true;
+    } else {
+      intset_remove(set, value - RANGE);
+      expected[value] = false;
+    }
+  }
+  return set;
+}
+
+// Checks that a set holds exactly the values flagged in an array.
+static bool matches(intset *set, bool *expected, const char *name) {
+  size_t length = 0;
+  for (int i = 0; i < 2 * RANGE; i++) {
+    if (intset_contains(set, i - RANGE) != expected[i]) {
+      fprintf(stderr, "%s: contains(%d) was wrong\n", name, i - RANGE);
+      return false;
+    }
+    length += expected[i];
+  }
+  if (intset_length(set) != length) {
+    fprintf(stderr, "%s: length was %lu, expected %lu\n", name,
+            intset_length(set), length);
+    return false;
+  }
+
+  int *values = malloc((length + 1) * sizeof(int));
+  size_t count = intset_to_array(set, values, length + 1);
+  for (size_t i = 1; i < count; i++) {
+    if (values[i - 1] >= values[i]) {
+      fprintf(stderr, "%s: array was not sorted\n", name);
+      free(values);
+      return false;
+    }
+  }
+  free(values);
+  if (count != length) {
+    fprintf(stderr, "%s: copied %lu values, expected %lu\n", name, count,
+            length);
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  intset *set = intset_create();
+  intset_add(set, 5);
+  intset_add(set, -70000);
+  intset_add(set, 70000);
+  intset_add(set, 5);
+  intset_add(set, 6);
+  intset_print(set);
+  printf("Length: %lu, contains 6: %d, contains 7: %d\n", intset_length(set),
+         intset_contains(set, 6), intset_contains(set, 7));
+  intset_remove(set, 5);
+  intset_remove(set, 100);
+  intset_print(set);
+
+  vector *vec = vector_create(1);
+  for (int i = 0; i < 10; i++) {
+    vector_push(vec, i * 2);
+  }
+  intset *evens = intset_create_from_vector(vec);
+  intset *both = intset_union(set, evens);
+  intset *common = intset_intersection(set, evens);
+  intset *rest = intset_difference(evens, set);
+  printf("Union: ");
+  intset_print(both);
+  printf("Intersection: ");
+  intset_print(common);
+  printf("Difference: ");
+  intset_print(rest);
+  intset_destroy(rest);
+  intset_destroy(common);
+  intset_destroy(both);
+  intset_destroy(evens);
+  intset_destroy(set);
+
+  // A million consecutive values fit in a few runs
+  vector_destroy(vec);
+  vec = vector_create(1000000);
+  for (int i = 0; i < 1000000; i++) {
+    vector_push(vec, i);
+  }
+  set = intset_create_from_vector(vec);
+  printf("Memory used by 1000000 consecutive values: %lu bytes\n",
+         intset_memory_usage(set));
+  intset_remove(set, 500000);
+  printf("Length after removing 500000: %lu, contains 499999: %d\n",
+         intset_length(set), intset_contains(set, 499999));
+  intset_destroy(set);
+
+  // Every other value compresses once added one at a time and optimized
+  set = intset_create();
+  for (int i = 0; i < 100000; i++) {
+    intset_add(set, i);
+  }
+  size_t before = intset_memory_usage(set);
+  intset_optimize(set);
+  printf("Memory used by 100000 added values: %lu bytes, %lu once "
+         "optimized\n",
+         before, intset_memory_usage(set));
+  intset_destroy(set);
+  vector_destroy(vec);
+
+  // Runs that edits break up go back to a bitmap instead of growing past it,
+  // whether the runs are split by removing values or started by adding them
+  intset *odds = intset_create();
+  for (int i = 1; i < 65536; i += 2) {
+    intset_add(odds, i);
+  }
+  set = intset_create();
+  for (int i = 0; i < 65536; i++) {
+    intset_add(set, i);
+  }
+  intset_optimize(set);
+  for (int i = 0; i < 65536; i += 2) {
+    intset_remove(set, i);
+  }
+  intset *added = intset_create();
+  for (int i = 1; i < 1000; i += 2) {
+    intset_add(added, i);
+  }
+  intset_optimize(added);
+  for (int i = 1001; i < 65536; i += 2) {
+    intset_add(added, i);
+  }
+  printf("Memory used by odd values below 65536: %lu bytes, %lu after "
+         "removing from runs, %lu after adding to runs\n",
+         intset_memory_usage(odds), intset_memory_usage(set),
+         intset_memory_usage(added));
+  if (intset_memory_usage(set) > intset_memory_usage(odds) ||
+      intset_memory_usage(added) > intset_memory_usage(odds) ||
+      !intset_equals(set, odds) || !intset_equals(added, odds)) {
+    fprintf(stderr, "Editing runs left too large or wrong containers\n");
+    return 1;
+  }
+  intset_destroy(added);
+  intset_destroy(set);
+  intset_destroy(odds);
+
+  // Empty sets have no chunks to compare
+  set = intset_create();
+  intset *other = intset_create();
+  if (!intset_equals(set, other)) {
+    fprintf(stderr, "Empty sets are not equal\n");
+    return 1;
+  }
+  intset_add(other, 7);
+  intset_remove(other, 7);
+  if (!intset_equals(set, other)) {
+    fprintf(stderr, "Emptied set is not equal to an empty set\n");
+    return 1;
+  }
+  intset_destroy(other);
+  intset_destroy(set);
+
+  // Check set algebra on random sets against arrays of flags, once with the
+  // scalar bitmap kernels and once with the fastest ones the machine has
+  bool *expected1 = malloc(2 * RANGE * sizeof(bool));
+  bool *expected2 = malloc(2 * RANGE * sizeof(bool));
+  bool *expected = malloc(2 * RANGE * sizeof(bool));
+  srand(31);
+  for (int round = 0; round < 4; round++) {
+    cpu_level level = round < 2 ? CPU_LEVEL_SCALAR : cpu_level_supported();
+    intset_force_kernels(level);
+    intset *set1 = random_set(expected1);
+    intset *set2 = random_set(expected2);
+    if (round % 2 == 1) {
+      intset_optimize(set2);
+    }
+    if (!matches(set1, expected1, "set1") ||
+        !matches(set2, expected2, "set2")) {
+      return 1;
+    }
+
+    intset *result = intset_union(set1, set2);
+    for (int i = 0; i < 2 * RANGE; i++) {
+      expected[i] = expected1[i] || expected2[i];
+    }
+    if (!matches(result, expected, "union")) {
+      return 1;
+    }
+    intset_destroy(result);
+
+    result = intset_intersection(set1, set2);
+    for (int i = 0; i < 2 * RANGE; i++) {
+      expected[i] = expected1[i] && expected2[i];
+    }
+    if (!matches(result, expected, "intersection")) {
+      return 1;
+    }
+    intset_destroy(result);
+
+    result = intset_difference(set1, set2);
+    for (int i = 0; i < 2 * RANGE; i++) {
+      expected[i] = expected1[i] && !expected2[i];
+    }
+    if (!matches(result, expected, "difference")) {
+      return 1;
+    }
+
+    intset *clone = intset_clone(set1);
+    intset_optimize(clone);
+    if (!intset_equals(set1, clone) || intset_equals(result, clone)) {
+      fprintf(stderr, "Comparing sets gave the wrong answer\n");
+      return 1;
+    }
+    intset_destroy(clone);
+    intset_destroy(result);
+    intset_destroy(set1);
+    intset_destroy(set2);
+  }
+  printf("Set algebra on random sets matches arrays with scalar and %s "
+         "kernels\n",
+         cpu_level_supported() == CPU_LEVEL_AVX2 ? "AVX2" : "scalar");
+  free(expected);
+  free(expected2);
+  free(expected1);
+}
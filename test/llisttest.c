@@ -1,5 +1,6 @@
 
 #include <stdio.h>
+#include <string.h>
 
 #include "../src/llist/llist.h"
 
@@ -118,4 +119,128 @@ int main() {
   llist_print(list);
 
   llist_destroy(list);
+
+  printf("\n");
+
+  llist_pool *pool = llist_pool_create(4);
+  list = llist_create_with_pool(pool);
+  list2 = llist_create_pooled();
+  for (int i = 0; i < 10; i++) {
+    llist_push_back(list, i);
+    llist_push_front(list2, i);
+  }
+  llist_print(list);
+  llist_print(list2);
+  printf("Removed %d and %d\n", llist_remove(list, 3), llist_remove(list2, 3));
+  llist_clear(list);
+  llist_clear(list2);
+  for (int i = 0; i < 5; i++) {
+    llist_push_back(list, i * 3);
+    llist_push_back(list2, i * 3);
+  }
+  equals = llist_equals(list, list2) ? "true" : "false";
+  printf("pooled list == pooled list2? %s\n", equals);
+  llist_print(list);
+  llist_destroy(list);
+  llist_destroy(list2);
+  llist_pool_destroy(pool);
+
+  printf("\n");
+
+  // Interleave the values with their squares and drop every odd value using a
+  // single pass of a cursor
+  int cursor_values[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  list = llist_create_from_values(cursor_values, 8);
+  llist_cursor cursor = llist_cursor_front(list);
+  while (!llist_cursor_at_end(&cursor)) {
+    value = llist_cursor_get(&cursor);
+    if (value % 2 == 1) {
+      llist_cursor_remove(&cursor);
+    } else {
+      llist_cursor_insert_after(&cursor, value * value);
+      llist_cursor_next(&cursor);
+      llist_cursor_next(&cursor);
+    }
+  }
+  llist_cursor_insert_before(&cursor, 100);
+  llist_print(list);
+
+  cursor = llist_cursor_back(list);
+  while (llist_cursor_index(&cursor) > 0) {
+    llist_cursor_set(&cursor, -llist_cursor_get(&cursor));
+    llist_cursor_prev(&cursor);
+  }
+  llist_cursor_insert_before(&cursor, 0);
+  cursor = llist_cursor_at(list, 3);
+  printf("Value at cursor index %lu is %d\n", llist_cursor_index(&cursor),
+         llist_cursor_get(&cursor));
+  llist_print(list);
+  llist_destroy(list);
+
+  printf("\n");
+
+  list = llist_create();
+  for (int i = 0; i < 1000; i++) {
+    llist_push_back(list, i);
+  }
+  llist_reset_stats(list);
+  long long sum = 0;
+  for (size_t i = 0; i < llist_length(list); i++) {
+    sum += llist_get(list, i);
+  }
+  llist_remove(list, 500);
+  llist_insert(list, 250, -1);
+  for (size_t i = 240; i < 260; i++) {
+    sum += llist_get(list, i);
+  }
+  llist_stats stats = llist_get_stats(list);
+  printf("sum = %lld, lookups = %lu, finger hits = %lu\n", sum, stats.lookups,
+         stats.finger_hits);
+  llist_destroy(list);
+
+  printf("\n");
+
+  int unsorted[10] = {5, 3, 9, 1, 7, 2, 8, 6, 4, 0};
+  list = llist_create_from_values(unsorted, 10);
+  list2 = llist_split_at(list, 5);
+  llist_print(list);
+  llist_print(list2);
+  llist_sort(list);
+  llist_sort(list2);
+  llist_merge(list, list2);
+  printf("Sorted and merged\n");
+  llist_print(list);
+  llist_reverse(list);
+  printf("Reversed\n");
+  llist_print(list);
+  llist_splice(list2, 0, list, 2, 3);
+  printf("Spliced 3 values out\n");
+  llist_print(list);
+  llist_print(list2);
+  llist_concat(list2, list);
+  printf("Concatenated\n");
+  llist_print(list);
+  llist_print(list2);
+  llist_destroy(list2);
+  llist_destroy(list);
+
+  printf("\n");
+
+  int bulk[1000];
+  for (int i = 0; i < 1000; i++) {
+    bulk[i] = i * 3;
+  }
+  list = llist_create_pooled_from_values(bulk, 1000);
+  llist_extend_from_array(list, unsorted, 10);
+  int copied[1010];
+  size_t count = llist_to_array(list, copied, 1010);
+  if (count != 1010 || memcmp(copied, bulk, sizeof(bulk)) != 0 ||
+      memcmp(copied + 1000, unsorted, sizeof(unsorted)) != 0 ||
+      llist_back(list) != 0 || llist_get(list, 999) != 2997) {
+    fprintf(stderr, "Bulk built list does not match array\n");
+    return 1;
+  }
+  printf("Bulk built list of %lu values, first 5 copied: %lu\n",
+         llist_length(list), llist_to_array(list, copied, 5));
+  llist_destroy(list);
 }
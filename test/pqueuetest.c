@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/pqueue/pqueue.h"
+
+// Inserts a value into an array sorted in descending order, so that the
+// smallest value stays at the end.
+static void insert_sorted(int *values, size_t *length, int value) {
+  size_t i = *length;
+  while (i > 0 && values[i - 1] < value) {
+    values[i] = values[i - 1];
+    i--;
+  }
+  values[i] = value;
+  (*length)++;
+}
+
+int main() {
+  pqueue *pq = pqueue_create(4, PQUEUE_BINARY);
+  int pushed[8] = {5, 3, 8, 1, 9, 2, 7, 3};
+  for (int i = 0; i < 8; i++) {
+    pqueue_push(pq, pushed[i]);
+  }
+  pqueue_print(pq);
+  printf("Length: %lu, peek: %d\n", pqueue_length(pq), pqueue_peek(pq));
+  printf("Push-popped 0: %d\n", pqueue_push_pop(pq, 0));
+  printf("Push-popped 4: %d\n", pqueue_push_pop(pq, 4));
+  printf("Replaced top with 10: %d\n", pqueue_replace_top(pq, 10));
+  printf("Popped:");
+  while (!pqueue_empty(pq)) {
+    printf(" %d", pqueue_pop(pq));
+  }
+  printf("\n");
+  pqueue_destroy(pq);
+
+  int values[10] = {9, 4, 7, 1, 8, 2, 6, 3, 5, 0};
+  pq = pqueue_create_from_array(values, 10, PQUEUE_DEFAULT_ARITY);
+  printf("Heapified with arity %lu: ", pqueue_arity(pq));
+  pqueue_print(pq);
+  pqueue_push_many(pq, values, 3);
+  printf("Pushed 3 values, popped:");
+  while (!pqueue_empty(pq)) {
+    printf(" %d", pqueue_pop(pq));
+  }
+  printf("\n");
+  pqueue_clear(pq);
+  printf("Cleared, empty: %d\n", pqueue_empty(pq));
+  pqueue_destroy(pq);
+
+  // Check random operations for several arities against an array kept sorted
+  // in descending order
+  size_t capacity = 100000;
+  int *expected = malloc(capacity * sizeof(int));
+  int *buffer = malloc(capacity * sizeof(int));
+  for (size_t arity = 2; arity <= 8; arity++) {
+    size_t length = 0;
+    srand(arity);
+    pq = pqueue_create_from_array(NULL, 0, arity);
+    for (int i = 0; i < 20000; i++) {
+      int op = rand() % 6;
+      int value = rand() % 1000;
+      if (op == 0 && length < capacity) {
+        pqueue_push(pq, value);
+        insert_sorted(expected, &length, value);
+      } else if ((op == 1 || op == 2) && length > 0) {
+        if (pqueue_pop(pq) != expected[--length]) {
+          fprintf(stderr, "Priority queue popped wrong value\n");
+          return 1;
+        }
+      } else if (op == 3) {
+        int top =
+            length > 0 && expected[length - 1] < value ? expected[length - 1]
+                                                       : value;
+        if (pqueue_push_pop(pq, value) != top) {
+          fprintf(stderr, "Priority queue push-popped wrong value\n");
+          return 1;
+        }
+        if (top != value) {
+          length--;
+          insert_sorted(expected, &length, value);
+        }
+      } else if (op == 4 && length > 0) {
+        if (pqueue_replace_top(pq, value) != expected[--length]) {
+          fprintf(stderr, "Priority queue replaced wrong value\n");
+          return 1;
+        }
+        insert_sorted(expected, &length, value);
+      } else if (op == 5) {
+        // Sometimes large enough that the whole heap is rebuilt
+        size_t n = rand() % 8;
+        if (rand() % 16 == 0 && length < 2000) {
+          n += length + 1;
+        }
+        if (length + n <= capacity) {
+          for (size_t j = 0; j < n; j++) {
+            buffer[j] = rand() % 1000;
+            insert_sorted(expected, &length, buffer[j]);
+          }
+          pqueue_push_many(pq, buffer, n);
+        }
+      }
+    }
+    if (pqueue_length(pq) != length) {
+      fprintf(stderr, "Priority queue has wrong length\n");
+      return 1;
+    }
+    while (length > 0) {
+      if (pqueue_pop(pq) != expected[--length]) {
+        fprintf(stderr, "Priority queue diverged from sorted array\n");
+        return 1;
+      }
+    }
+    pqueue_destroy(pq);
+  }
+  printf("Priority queues match sorted arrays after random operations\n");
+  free(buffer);
+  free(expected);
+}
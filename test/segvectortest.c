@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/segvector/segvector.h"
+
+// Number of pushing threads in the concurrent check.
+#define WRITERS 4
+
+// Number of values pushed by each of them.
+#define PER_WRITER 200000
+
+typedef struct writer {
+  segvector *sv;
+  int id;
+} writer;
+
+// Pushes PER_WRITER values tagged with the writer's id, some of them in
+// batches.
+static void *push_values(void *arg) {
+  writer *w = arg;
+  int batch[50];
+  for (int i = 0; i < PER_WRITER;) {
+    if (i % 1000 == 0 && PER_WRITER - i >= 50) {
+      for (int j = 0; j < 50; j++) {
+        batch[j] = w->id * PER_WRITER + i + j;
+      }
+      i += segvector_push_many(w->sv, batch, 50, NULL);
+    } else {
+      segvector_push(w->sv, w->id * PER_WRITER + i, NULL);
+      i++;
+    }
+  }
+  return NULL;
+}
+
+// Reads published values while the writers are running and checks that each
+// of them is one that was pushed, until all of them have been seen.
+static void *read_values(void *arg) {
+  segvector *sv = arg;
+  size_t seen = 0;
+  while (seen < (size_t)WRITERS * PER_WRITER) {
+    seen = 0;
+    size_t length = segvector_length(sv);
+    for (size_t i = 0; i < length; i++) {
+      int value;
+      if (segvector_get(sv, i, &value)) {
+        if (value < 0 || value >= WRITERS * PER_WRITER) {
+          fprintf(stderr, "Read a value that was never pushed\n");
+          exit(1);
+        }
+        seen++;
+      }
+    }
+  }
+  return NULL;
+}
+
+int main() {
+  segvector *sv = segvector_create(1000);
+  printf("Capacity: %lu, length: %lu\n", segvector_capacity(sv),
+         segvector_length(sv));
+  int value;
+  printf("Get before push: %d\n", segvector_get(sv, 0, &value));
+
+  size_t index;
+  for (int i = 0; i < 100; i++) {
+    segvector_push(sv, i * i, &index);
+  }
+  int *pointer = segvector_at(sv, 9);
+  printf("Last index: %lu, [9]: %d\n", index, *pointer);
+
+  // Growing into new segments never moves existing values
+  int values[500];
+  for (int i = 0; i < 500; i++) {
+    values[i] = -i;
+  }
+  size_t first;
+  size_t pushed = segvector_push_many(sv, values, 500, &first);
+  printf("Pushed %lu values from index %lu, [9] still at same address: %d\n",
+         pushed, first, segvector_at(sv, 9) == pointer);
+  segvector_get(sv, 599, &value);
+  printf("[599]: %d\n", value);
+
+  pushed = segvector_push_many(sv, values, 500, &first);
+  printf("Pushed %lu values into the remaining space\n", pushed);
+  printf("Push when full: %d, length: %lu\n", segvector_push(sv, 1, NULL),
+         segvector_length(sv));
+  printf("Pointer past capacity is NULL: %d\n", segvector_at(sv, 1000) == NULL);
+  segvector_destroy(sv);
+
+  // Check that concurrent pushes each land at an index of their own while
+  // a reader looks on
+  sv = segvector_create(WRITERS * PER_WRITER);
+  pthread_t reader;
+  pthread_t threads[WRITERS];
+  writer writers[WRITERS];
+  if (pthread_create(&reader, NULL, read_values, sv) != 0) {
+    fprintf(stderr, "Failed to start reader thread\n");
+    return 1;
+  }
+  for (int i = 0; i < WRITERS; i++) {
+    writers[i] = (writer){sv, i};
+    if (pthread_create(&threads[i], NULL, push_values, &writers[i]) != 0) {
+      fprintf(stderr, "Failed to start writer thread\n");
+      return 1;
+    }
+  }
+  for (int i = 0; i < WRITERS; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  pthread_join(reader, NULL);
+
+  bool *found = calloc(WRITERS * PER_WRITER, sizeof(bool));
+  for (size_t i = 0; i < segvector_length(sv); i++) {
+    if (!segvector_get(sv, i, &value) || found[value]) {
+      fprintf(stderr, "Value missing or pushed twice at index %lu\n", i);
+      return 1;
+    }
+    found[value] = true;
+  }
+  printf("All %lu values from %d writers were pushed exactly once\n",
+         segvector_length(sv), WRITERS);
+  free(found);
+  segvector_destroy(sv);
+}
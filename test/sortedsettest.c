@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/sortedset/sortedset.h"
+#include "../src/vector/vector.h"
+
+int main() {
+  int values[10] = {42, 7, 19, 7, -3, 100, 56, 19, 0, 88};
+  vector *vec = vector_create(10);
+  vector_push_many(vec, values, 10);
+  vector_print(vec);
+
+  sortedset *set = sortedset_create_from_vector(vec);
+  printf("Sorted set holds %lu distinct values\n", sortedset_length(set));
+
+  for (int value = -5; value <= 105; value += 11) {
+    int bound;
+    char *contains = sortedset_contains(set, value) ? "true" : "false";
+    printf("contains %d? %s, rank %lu, ", value, contains,
+           sortedset_rank(set, value));
+    if (sortedset_lower_bound(set, value, &bound)) {
+      printf("lower bound %d\n", bound);
+    } else {
+      printf("no lower bound\n");
+    }
+  }
+  sortedset_destroy(set);
+  vector_destroy(vec);
+
+  printf("\n");
+
+  // Compare against a plain scan on a larger set
+  vec = vector_create(1);
+  for (int i = 0; i < 10000; i++) {
+    vector_push(vec, rand() % 30000 - 15000);
+  }
+  set = sortedset_create_from_vector(vec);
+  int queries[1000];
+  bool contained[1000];
+  size_t ranks[1000];
+  for (int i = 0; i < 1000; i++) {
+    queries[i] = rand() % 32000 - 16000;
+  }
+  sortedset_contains_many(set, queries, 1000, contained);
+  sortedset_rank_many(set, queries, 1000, ranks);
+  vector_sort(vec);
+  for (int i = 0; i < 1000; i++) {
+    size_t rank = 0;
+    for (size_t j = 0; j < vector_length(vec); j++) {
+      int value = vector_get(vec, j);
+      if (value < queries[i] && (j == 0 || value != vector_get(vec, j - 1))) {
+        rank++;
+      }
+    }
+    bool contains = vector_contains(vec, queries[i]);
+    if (contained[i] != contains ||
+        sortedset_contains(set, queries[i]) != contains || ranks[i] != rank ||
+        sortedset_rank(set, queries[i]) != rank) {
+      fprintf(stderr, "Sorted set disagrees with a plain scan for %d\n",
+              queries[i]);
+      return 1;
+    }
+  }
+  printf("Sorted set of %lu values agrees with a plain scan\n",
+         sortedset_length(set));
+  sortedset_destroy(set);
+  vector_destroy(vec);
+}
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include "../src/spsc/spsc.h"
+
+// Number of values passed between threads.
+#define COUNT 2000000
+
+static void *produce(void *arg) {
+  spsc *q = arg;
+  int batch[37];
+  int next = 0;
+  while (next < COUNT) {
+    if (next % 3 == 0) {
+      // Push a batch of values
+      int n = COUNT - next < 37 ? COUNT - next : 37;
+      for (int i = 0; i < n; i++) {
+        batch[i] = next + i;
+      }
+      int pushed = 0;
+      while (pushed < n) {
+        size_t count = spsc_push_many(q, batch + pushed, n - pushed);
+        if (count == 0) {
+          sched_yield();
+        }
+        pushed += count;
+      }
+      next += n;
+    } else {
+      while (!spsc_push(q, next)) {
+        sched_yield();
+      }
+      next++;
+    }
+  }
+  return NULL;
+}
+
+int main() {
+  spsc *q = spsc_create(5);
+  printf("Capacity: %lu\n", spsc_capacity(q));
+  for (int i = 0; i < 10; i++) {
+    if (!spsc_push(q, i)) {
+      printf("Full after %d values\n", i);
+      break;
+    }
+  }
+  int value;
+  spsc_pop(q, &value);
+  printf("Popped %d, length: %lu\n", value, spsc_length(q));
+  int values[8] = {10, 11, 12, 13, 14, 15, 16, 17};
+  printf("Pushed %lu of 8 values\n", spsc_push_many(q, values, 8));
+  int popped[16];
+  size_t count = spsc_pop_many(q, popped, 16);
+  printf("Popped %lu values:", count);
+  for (size_t i = 0; i < count; i++) {
+    printf(" %d", popped[i]);
+  }
+  printf("\n");
+  printf("Pop from empty queue succeeded: %d\n", spsc_pop(q, &value));
+  spsc_destroy(q);
+
+  // Pass values from a producer thread to this thread, which checks that they
+  // arrive complete and in order
+  q = spsc_create(64);
+  pthread_t producer;
+  if (pthread_create(&producer, NULL, produce, q) != 0) {
+    fprintf(stderr, "Failed to start producer thread\n");
+    return 1;
+  }
+  int expected = 0;
+  while (expected < COUNT) {
+    size_t n = expected % 2 == 0 ? spsc_pop_many(q, popped, 16)
+                                 : spsc_pop(q, popped);
+    if (n == 0) {
+      sched_yield();
+    }
+    for (size_t i = 0; i < n; i++) {
+      if (popped[i] != expected) {
+        fprintf(stderr, "SPSC queue delivered %d, expected %d\n", popped[i],
+                expected);
+        return 1;
+      }
+      expected++;
+    }
+  }
+  pthread_join(producer, NULL);
+  printf("Passed %d values between threads in order\n", expected);
+  spsc_destroy(q);
+}
@@ -0,0 +1,194 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/ulist/ulist.h"
+
+// Number of values the lists checked against arrays start out with, which is
+// enough for a few nodes.
+#define LENGTH 100
+
+// Checks that a given list holds exactly the values of a given array.
+static bool holds(ulist *list, const int *values, size_t length) {
+  if (ulist_length(list) != length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (ulist_get(list, i) != values[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  ulist *list = ulist_create();
+  ulist_print(list);
+
+  ulist_insert(list, 0, 42);
+  ulist_print(list);
+
+  ulist_insert(list, 0, 84);
+  ulist_print(list);
+
+  ulist_insert(list, 2, 168);
+  ulist_print(list);
+
+  ulist_insert(list, 1, 336);
+  ulist_print(list);
+
+  printf("\n");
+
+  int value = ulist_remove(list, 2);
+  printf("Removed %d\n", value);
+  ulist_print(list);
+
+  printf("\n");
+
+  for (int i = 0; i < 10; i++) {
+    ulist_push_back(list, i * 2);
+    ulist_push_front(list, i * 2);
+    ulist_print(list);
+  }
+
+  printf("\n");
+
+  value = ulist_pop_back(list);
+  printf("Popped %d from back\n", value);
+  ulist_print(list);
+
+  value = ulist_pop_front(list);
+  printf("Popped %d from front\n", value);
+  ulist_print(list);
+
+  printf("\n");
+
+  value = ulist_back(list);
+  printf("Peeked %d from back\n", value);
+  ulist_print(list);
+
+  value = ulist_front(list);
+  printf("Peeked %d from front\n", value);
+  ulist_print(list);
+
+  printf("\n");
+
+  ulist_set(list, 9, 12345);
+
+  for (size_t i = 0; i < ulist_length(list); i++) {
+    printf("%d ", ulist_get(list, i));
+  }
+  printf("\n");
+
+  printf("\n");
+
+  size_t position;
+  for (int i = ulist_length(list) - 1; i >= 0; i--) {
+    value = ulist_get(list, i);
+    if (ulist_position(list, value, &position)) {
+      printf("Found %d at index %lu\n", value, position);
+    } else {
+      printf("Did not find %d\n", value);
+    }
+  }
+  if (ulist_position(list, 54321, &position)) {
+    printf("Found %d at index %lu\n", 54321, position);
+  } else {
+    printf("Did not find %d\n", 54321);
+  }
+
+  printf("\n");
+
+  int values[21] = {16,  14, 12, 10, 8, 6, 4,  2,  0,  12345, 336,
+                    168, 0,  2,  4,  6, 8, 10, 12, 14, 16};
+  ulist *list2 = ulist_create_from_values(values, 21);
+  ulist_print(list2);
+
+  char *equals = ulist_equals(list, list) ? "true" : "false";
+  printf("list == list? %s\n", equals);
+  equals = ulist_equals(list, list2) ? "true" : "false";
+  printf("list == list2? %s\n", equals);
+  equals = ulist_equals(list, list2) ? "true" : "false";
+  ulist_destroy(list2);
+
+  list2 = ulist_create();
+  ulist_print(list2);
+  ulist_push_back(list2, 42);
+  equals = ulist_equals(list, list2) ? "true" : "false";
+  printf("list == list2? %s\n", equals);
+  ulist_destroy(list2);
+
+  printf("\n");
+
+  char *contains;
+  for (int i = ulist_length(list) - 1; i >= 0; i--) {
+    value = ulist_get(list, i);
+    contains = ulist_contains(list, value) ? "true" : "false";
+    printf("list contains %d? %s\n", value, contains);
+  }
+  value = 54321;
+  contains = ulist_contains(list, value) ? "true" : "false";
+  printf("list contains %d? %s\n", value, contains);
+
+  printf("\n");
+
+  ulist_clear(list);
+  ulist_print(list);
+
+  ulist_destroy(list);
+
+  printf("\n");
+
+  // Lists created from values have full nodes, so inserting at every index
+  // splits a full node at every offset, including both ends of a node
+  int expected[LENGTH + 2];
+  for (size_t index = 0; index <= LENGTH; index++) {
+    for (int i = 0; i < LENGTH; i++) {
+      expected[i] = i;
+    }
+    list = ulist_create_from_values(expected, LENGTH);
+    memmove(expected + index + 1, expected + index,
+            (LENGTH - index) * sizeof(int));
+    expected[index] = -1;
+    ulist_insert(list, index, -1);
+    // A second insert right after lands in one of the halves of the split
+    memmove(expected + index + 1, expected + index,
+            (LENGTH + 1 - index) * sizeof(int));
+    expected[index] = -2;
+    ulist_insert(list, index, -2);
+    if (!holds(list, expected, LENGTH + 2)) {
+      fprintf(stderr, "Unrolled list lost values splitting at %lu\n", index);
+      return 1;
+    }
+    ulist_destroy(list);
+  }
+  printf("Unrolled list splits full nodes at every offset\n");
+
+  // Removing over and over at one index drains the node holding it below
+  // half full, which merges it into the next node or, at the tail, into the
+  // previous one
+  for (size_t index = 0; index < LENGTH; index++) {
+    for (int i = 0; i < LENGTH; i++) {
+      expected[i] = i;
+    }
+    list = ulist_create_from_values(expected, LENGTH);
+    size_t length = LENGTH;
+    while (length > 0) {
+      size_t at = index < length ? index : length - 1;
+      if (ulist_remove(list, at) != expected[at]) {
+        fprintf(stderr, "Unrolled list removed the wrong value at %lu\n", at);
+        return 1;
+      }
+      memmove(expected + at, expected + at + 1,
+              (length - at - 1) * sizeof(int));
+      length--;
+      if (!holds(list, expected, length)) {
+        fprintf(stderr, "Unrolled list lost values merging at %lu\n", at);
+        return 1;
+      }
+    }
+    ulist_destroy(list);
+  }
+  printf("Unrolled list merges drained nodes at every index\n");
+}
@@ -20,9 +20,73 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <limits.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "../src/vector/vector.h"
+#include "../src/vector/vector_generic.h"
+#include "../src/vector/vector_inline.h"
+
+typedef struct point {
+  double x;
+  double y;
+} point;
+
+VECTOR_DEFINE_INLINE(point_vector, point)
+
+// Checks the search and aggregation functions of a given vector against plain
+// loops over its values.
+static bool check_search(vector *vec) {
+  size_t length = vector_length(vec);
+  int64_t sum = 0;
+  int min = vector_get(vec, 0);
+  int max = vector_get(vec, 0);
+  for (size_t i = 0; i < length; i++) {
+    int value = vector_get(vec, i);
+    sum += value;
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+  }
+  if (vector_sum(vec) != sum || vector_min(vec) != min ||
+      vector_max(vec) != max || vector_contains(vec, 12345)) {
+    return false;
+  }
+
+  // Search for values that are missing, rare and common
+  for (int value = -52; value <= 52; value += 13) {
+    size_t count = 0;
+    size_t first = length;
+    for (size_t i = 0; i < length; i++) {
+      if (vector_get(vec, i) == value) {
+        first = count == 0 ? i : first;
+        count++;
+      }
+    }
+    size_t index;
+    bool found = vector_find(vec, value, &index);
+    if (vector_count(vec, value) != count || found != (count > 0) ||
+        (found && index != first) ||
+        vector_contains(vec, value) != (count > 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Sorts a copy of `vec` using `nthreads` threads and checks that it matches
+// `sorted`.
+static bool check_parallel_sort(vector *vec, vector *sorted, size_t nthreads) {
+  vector *copy = vector_create(1);
+  vector_extend_from(copy, vec);
+  bool ok = vector_sort_parallel(copy, nthreads);
+  for (size_t i = 0; ok && i < vector_length(sorted); i++) {
+    ok = vector_get(copy, i) == vector_get(sorted, i);
+  }
+  vector_destroy(copy);
+  return ok;
+}
 
 int main() {
   vector *vec = vector_create(10);
@@ -65,5 +129,177 @@ int main() {
   printf("Removed %d\n", removed);
   vector_print(vec);
 
+  printf("\n");
+
+  int values[6] = {10, 11, 12, 13, 14, 15};
+  if (!vector_push_many(vec, values, 6)) {
+    fprintf(stderr, "Failed to push values onto vector");
+    return 1;
+  }
+  printf("Pushed 6 values\n");
+  vector_print(vec);
+
+  if (!vector_insert_range(vec, 1, values, 3)) {
+    fprintf(stderr, "Failed to insert values into vector");
+    return 1;
+  }
+  printf("Inserted 3 values at index 1\n");
+  vector_print(vec);
+
+  int removed_values[4];
+  if (!vector_remove_range(vec, 2, 4, removed_values)) {
+    fprintf(stderr, "Failed to remove values from vector");
+    return 1;
+  }
+  printf("Removed %d %d %d %d\n", removed_values[0], removed_values[1],
+         removed_values[2], removed_values[3]);
+  vector_print(vec);
+
+  if (!vector_extend_from(vec, vec)) {
+    fprintf(stderr, "Failed to extend vector");
+    return 1;
+  }
+  printf("Extended vector with itself\n");
+  vector_print(vec);
+
+  vector_destroy(vec);
+
+  printf("\n");
+
+  vec = vector_create_inline(4);
+  for (int i = 0; i < 6; i++) {
+    vector_push(vec, i);
+    printf("Pushed %d, capacity is %lu\n", i, vector_capacity(vec));
+  }
+  for (int i = 0; i < 3; i++) {
+    vector_pop(vec, &removed);
+  }
+  vector_shrink_to_fit(vec);
+  printf("Shrunk to fit, capacity is %lu\n", vector_capacity(vec));
+  vector_print(vec);
+  vector_destroy(vec);
+
+  printf("\n");
+
+  vector_policy policy = vector_default_policy();
+  policy.growth_factor = 1.5;
+  policy.auto_shrink = false;
+  vec = vector_create_with_policy(10, &policy);
+  for (int i = 0; i < 20; i++) {
+    vector_push(vec, i);
+  }
+  printf("Pushed 20 values, capacity is %lu\n", vector_capacity(vec));
+  for (int i = 0; i < 18; i++) {
+    vector_pop(vec, &removed);
+  }
+  printf("Popped 18 values, capacity is %lu\n", vector_capacity(vec));
+  vector_shrink_to_fit(vec);
+  printf("Shrunk to fit, capacity is %lu\n", vector_capacity(vec));
+  vector_reserve(vec, 100);
+  printf("Reserved 100, capacity is %lu\n", vector_capacity(vec));
+  vector_print(vec);
+
+  for (int *it = vector_begin(vec); it != vector_end(vec); it++) {
+    *it *= 10;
+  }
+  vector_set_unchecked(vec, 0, vector_get_unchecked(vec, 0) + 1);
+  for (size_t i = 0; i < vector_length_unchecked(vec); i++) {
+    printf("%d ", vector_data(vec)[i]);
+  }
+  printf("\n");
+
+  vector_destroy(vec);
+
+  printf("\n");
+
+  point_vector *points = point_vector_create(2);
+  for (int i = 0; i < 5; i++) {
+    point p = {i, i * 0.5};
+    point_vector_push(points, p);
+  }
+  point p = {-1, -1};
+  point_vector_insert(points, 2, p);
+  point_vector_remove(points, 0, &p);
+  printf("Removed (%.1f, %.1f)\n", p.x, p.y);
+  for (size_t i = 0; i < point_vector_length(points); i++) {
+    p = point_vector_get(points, i);
+    printf("(%.1f, %.1f) ", p.x, p.y);
+  }
+  printf("\n");
+  point_vector_destroy(points);
+
+  printf("\n");
+
+  // Check the search kernels of every CPU level the machine supports against
+  // plain loops, over lengths that leave every possible tail
+  const char *level_names[3] = {"scalar", "SSE2", "AVX2"};
+  for (int level = CPU_LEVEL_SCALAR; level <= CPU_LEVEL_AVX2; level++) {
+    if (!vector_force_kernels(level)) {
+      printf("%s kernels: not supported\n", level_names[level]);
+      continue;
+    }
+    for (int length = 1; length <= 200; length++) {
+      vec = vector_create(length);
+      for (int i = 0; i < length; i++) {
+        // Mostly small values with the odd extreme one
+        int value = rand() % 100 - 50;
+        if (rand() % 50 == 0) {
+          value = rand() % 2 == 0 ? INT_MIN : INT_MAX;
+        }
+        vector_push(vec, value);
+      }
+      if (!check_search(vec)) {
+        fprintf(stderr, "%s search kernels disagree with a plain loop\n",
+                level_names[level]);
+        return 1;
+      }
+      vector_destroy(vec);
+    }
+    printf("%s kernels agree with plain loops\n", level_names[level]);
+  }
+  vector_force_kernels(cpu_level_supported());
+
+  printf("\n");
+
+  vec = vector_create(1);
+  for (int i = 0; i < 100000; i++) {
+    vector_push(vec, rand() - RAND_MAX / 2);
+  }
+  vector *sorted = vector_create(1);
+  vector_extend_from(sorted, vec);
+  printf("Sorted before sorting? %s\n",
+         vector_is_sorted(sorted) ? "true" : "false");
+  if (!vector_sort(sorted)) {
+    fprintf(stderr, "Failed to sort vector");
+    return 1;
+  }
+  printf("Sorted after sorting? %s\n",
+         vector_is_sorted(sorted) ? "true" : "false");
+  // 100000 values allow up to 6 chunks, so odd thread counts leave a run to
+  // carry over between merge rounds, and 7 threads get capped
+  for (size_t nthreads = 1; nthreads <= 7; nthreads++) {
+    if (!check_parallel_sort(vec, sorted, nthreads)) {
+      fprintf(stderr, "Parallel sort with %zu threads disagrees with "
+                      "sequential sort", nthreads);
+      return 1;
+    }
+  }
+  vector_destroy(sorted);
+  vector_destroy(vec);
+  // More threads than values
+  vec = vector_create(1);
+  for (int i = 0; i < 10; i++) {
+    vector_push(vec, 5 - i);
+  }
+  sorted = vector_create(1);
+  vector_extend_from(sorted, vec);
+  vector_sort(sorted);
+  if (!check_parallel_sort(vec, sorted, 11)) {
+    fprintf(stderr, "Parallel sort with more threads than values disagrees "
+                    "with sequential sort");
+    return 1;
+  }
+  printf("Parallel sort agrees with sequential sort\n");
+  vector_destroy(sorted);
   vector_destroy(vec);
 }
@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2022 Mathias Estrup
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/wsdeque/wsdeque.h"
+
+// Number of items pushed by the owner during the stress test.
+#define COUNT 200000
+
+// Number of threads stealing during the stress test.
+#define THIEVES 3
+
+typedef struct shared {
+  wsdeque *dq;
+  // How many times each item was taken. Every item must be taken once.
+  atomic_int *taken;
+  atomic_bool done;
+} shared;
+
+static void take(shared *s, void *item) {
+  atomic_fetch_add_explicit(&s->taken[*(int *)item], 1,
+                            memory_order_relaxed);
+}
+
+static void *steal(void *arg) {
+  shared *s = arg;
+  while (!atomic_load(&s->done) || wsdeque_length(s->dq) > 0) {
+    void *item;
+    if (wsdeque_steal(s->dq, &item)) {
+      take(s, item);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+int main() {
+  wsdeque *dq = wsdeque_create(2);
+  int values[6] = {0, 1, 2, 3, 4, 5};
+  for (int i = 0; i < 6; i++) {
+    wsdeque_push(dq, &values[i]);
+  }
+  printf("Length: %lu\n", wsdeque_length(dq));
+  void *item;
+  wsdeque_pop(dq, &item);
+  printf("Popped %d from bottom\n", *(int *)item);
+  wsdeque_steal(dq, &item);
+  printf("Stole %d from top\n", *(int *)item);
+  printf("Remaining:");
+  while (wsdeque_pop(dq, &item)) {
+    printf(" %d", *(int *)item);
+  }
+  printf("\n");
+  printf("Steal from empty deque succeeded: %d\n", wsdeque_steal(dq, &item));
+  wsdeque_destroy(dq);
+
+  // The owner pushes items, growing the deque from tiny, and pops some of
+  // them while thieves steal the rest. Items point to their own indices.
+  int *ids = malloc(COUNT * sizeof(int));
+  for (int i = 0; i < COUNT; i++) {
+    ids[i] = i;
+  }
+  shared s;
+  s.dq = wsdeque_create(1);
+  s.taken = calloc(COUNT, sizeof(atomic_int));
+  atomic_init(&s.done, false);
+  pthread_t thieves[THIEVES];
+  for (int i = 0; i < THIEVES; i++) {
+    if (pthread_create(&thieves[i], NULL, steal, &s) != 0) {
+      fprintf(stderr, "Failed to start thief thread\n");
+      return 1;
+    }
+  }
+  for (int i = 0; i < COUNT; i++) {
+    wsdeque_push(s.dq, &ids[i]);
+    if (i % 3 == 0 && wsdeque_pop(s.dq, &item)) {
+      take(&s, item);
+    }
+  }
+  while (wsdeque_pop(s.dq, &item)) {
+    take(&s, item);
+  }
+  atomic_store(&s.done, true);
+  for (int i = 0; i < THIEVES; i++) {
+    pthread_join(thieves[i], NULL);
+  }
+
+  for (int i = 0; i < COUNT; i++) {
+    if (atomic_load(&s.taken[i]) != 1) {
+      fprintf(stderr, "Item %d was taken %d times\n", i,
+              atomic_load(&s.taken[i]));
+      return 1;
+    }
+  }
+  printf("Every one of %d items was taken exactly once\n", COUNT);
+  wsdeque_destroy(s.dq);
+  free(s.taken);
+  free(ids);
+}